@@ -38,6 +38,21 @@ void assign(std::mt19937& gen, std::uniform_real_distribution<HPDDM::underlying_
     x = K(dis(gen), dis(gen));
 }
 
+HPDDM::underlying_type<K> source(HPDDM::underlying_type<K> x, HPDDM::underlying_type<K> y) {
+    int Nf = 3;
+    HPDDM::underlying_type<K> xsc[3] = { 6.5, 2.0, 7.0 };
+    HPDDM::underlying_type<K> ysc[3] = { 8.0, 7.0, 3.0 };
+    HPDDM::underlying_type<K> rsc[3] = { 0.3, 0.3, 0.4 };
+    HPDDM::underlying_type<K> asc[3] = { 0.3, 0.2, -0.1 };
+    HPDDM::underlying_type<K> frs = 1.0;
+    for(int n = 0; n < Nf; ++n) {
+        HPDDM::underlying_type<K> xdist = (x - xsc[n]), ydist = (y - ysc[n]);
+        if(sqrt(xdist * xdist + ydist * ydist) <= rsc[n])
+            frs -= asc[n] * cos(0.5 * pi * xdist / rsc[n]) * cos(0.5 * pi * ydist / rsc[n]);
+    }
+    return frs;
+}
+
 void generate(int rankWorld, int sizeWorld, std::list<int>& o, std::vector<std::vector<int>>& mapping, int& ndof, HPDDM::MatrixCSR<K>*& Mat, HPDDM::MatrixCSR<K>*& MatNeumann, HPDDM::underlying_type<K>*& d, K*& f, K*& sol) {
     HPDDM::Option& opt = *HPDDM::Option::get();
     const int Nx = opt.app()["Nx"];
@@ -68,22 +83,9 @@ void generate(int rankWorld, int sizeWorld, std::list<int>& o, std::vector<std::
     HPDDM::underlying_type<K> dx = (xdim[1] - xdim[0]) / static_cast<HPDDM::underlying_type<K>>(Nx);
     HPDDM::underlying_type<K> dy = (ydim[1] - ydim[0]) / static_cast<HPDDM::underlying_type<K>>(Ny);
     if(mu == 0) {
-        int Nf = 3;
-        HPDDM::underlying_type<K> xsc[3] = { 6.5, 2.0, 7.0 };
-        HPDDM::underlying_type<K> ysc[3] = { 8.0, 7.0, 3.0 };
-        HPDDM::underlying_type<K> rsc[3] = { 0.3, 0.3, 0.4 };
-        HPDDM::underlying_type<K> asc[3] = { 0.3, 0.2, -0.1 };
-        for(int j = jStart, k = 0; j < jEnd; ++j) {
-            for(int i = iStart; i < iEnd; ++i, ++k) {
-                HPDDM::underlying_type<K> frs = 1.0;
-                for(int n = 0; n < Nf; ++n) {
-                    HPDDM::underlying_type<K> xdist = (xx(i) - xsc[n]), ydist = (yy(j) - ysc[n]);
-                    if(sqrt(xdist * xdist + ydist * ydist) <= rsc[n])
-                        frs -= asc[n] * cos(0.5 * pi * xdist / rsc[n]) * cos(0.5 * pi * ydist / rsc[n]);
-                    f[k] = frs;
-                }
-            }
-        }
+        for(int j = jStart, k = 0; j < jEnd; ++j)
+            for(int i = iStart; i < iEnd; ++i, ++k)
+                f[k] = source(xx(i), yy(j));
     }
     else {
         std::random_device rd;
@@ -342,3 +344,70 @@ void generate(int rankWorld, int sizeWorld, std::list<int>& o, std::vector<std::
         }
     }
 }
+
+void generateRows(int rankWorld, int sizeWorld, int& first, HPDDM::MatrixCSR<K>*& Mat, std::vector<HPDDM::underlying_type<K>>& coordinates) {
+    HPDDM::Option& opt = *HPDDM::Option::get();
+    const int Nx = opt.app()["Nx"];
+    const int Ny = opt.app()["Ny"];
+    HPDDM::underlying_type<K> xdim[2] = { 0.0, 10.0 };
+    HPDDM::underlying_type<K> ydim[2] = { 0.0, 10.0 };
+    HPDDM::underlying_type<K> dx = (xdim[1] - xdim[0]) / static_cast<HPDDM::underlying_type<K>>(Nx);
+    HPDDM::underlying_type<K> dy = (ydim[1] - ydim[0]) / static_cast<HPDDM::underlying_type<K>>(Ny);
+    first = (rankWorld * static_cast<long long>(Nx * Ny)) / sizeWorld;
+    const int last = ((rankWorld + 1) * static_cast<long long>(Nx * Ny)) / sizeWorld;
+    constexpr char N = HPDDM_NUMBERING;
+    std::vector<int> ia(1, (N == 'F')), ja;
+    std::vector<K> a;
+    ja.reserve(5 * (last - first));
+    a.reserve(5 * (last - first));
+    coordinates.clear();
+    coordinates.reserve(2 * (last - first));
+    for(int k = first; k < last; ++k) { // unknown (i, j) of the grid is the row i + j * Nx of the global matrix
+        const int i = k % Nx, j = k / Nx;
+        if(j > 0) {
+            a.emplace_back(-1 / (dy * dy));
+            ja.emplace_back(k - Nx + (N == 'F'));
+        }
+        if(i > 0) {
+            a.emplace_back(-1 / (dx * dx));
+            ja.emplace_back(k - 1 + (N == 'F'));
+        }
+        a.emplace_back(2 / (dx * dx) + 2 / (dy * dy));
+        ja.emplace_back(k + (N == 'F'));
+        if(i < Nx - 1) {
+            a.emplace_back(-1 / (dx * dx));
+            ja.emplace_back(k + 1 + (N == 'F'));
+        }
+        if(j < Ny - 1) {
+            a.emplace_back(-1 / (dy * dy));
+            ja.emplace_back(k + Nx + (N == 'F'));
+        }
+        ia.emplace_back(ja.size() + (N == 'F'));
+        coordinates.emplace_back(xx(i));
+        coordinates.emplace_back(yy(j));
+    }
+    Mat = new HPDDM::MatrixCSR<K>(last - first, Nx * Ny, a.size(), false);
+    std::copy(ia.cbegin(), ia.cend(), Mat->_ia);
+    std::copy(ja.cbegin(), ja.cend(), Mat->_ja);
+    std::copy(a.cbegin(), a.cend(), Mat->_a);
+}
+
+void generateRhs(const std::vector<int>& numbering, int first, int ndof, const std::vector<HPDDM::underlying_type<K>>& coordinates, K*& f, K*& sol) {
+    HPDDM::Option& opt = *HPDDM::Option::get();
+    const int mu = opt.app()["generate_random_rhs"];
+    f = new K[std::max(1, mu) * ndof]();
+    sol = new K[std::max(1, mu) * ndof]();
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<HPDDM::underlying_type<K>> dis(0.0, 1.0);
+    for(int i = 0; i < ndof; ++i) {
+        const unsigned int k = numbering[i] - first;
+        if(k < coordinates.size() / 2) { // only the local rows of the global matrix are filled
+            if(mu == 0)
+                f[i] = source(coordinates[2 * k], coordinates[2 * k + 1]);
+            else
+                for(int nu = 0; nu < mu; ++nu)
+                    assign(gen, dis, f[nu * ndof + i]);
+        }
+    }
+}
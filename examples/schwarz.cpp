@@ -52,7 +52,9 @@ int main(int argc, char** argv) {
         std::forward_as_tuple("Ny=<100>", "Number of grid points in the y-direction.", HPDDM::Option::Arg::positive),
         std::forward_as_tuple("generate_random_rhs=<0>", "Number of generated random right-hand sides.", HPDDM::Option::Arg::integer),
         std::forward_as_tuple("symmetric_csr=(0|1)", "Assemble symmetric matrices.", HPDDM::Option::Arg::argument),
-        std::forward_as_tuple("nonuniform=(0|1)", "Use a different number of eigenpairs to compute on each subdomain.", HPDDM::Option::Arg::argument)
+        std::forward_as_tuple("nonuniform=(0|1)", "Use a different number of eigenpairs to compute on each subdomain.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("algebraic_overlap=(0|1|2)", "Build the overlap from nonoverlapping rows of the global matrix, migrated beforehand by a recursive coordinate bisection if set to 2.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("smooth_partition=(0|1)", "Use a partition of unity decreasing linearly in the algebraic overlap.", HPDDM::Option::Arg::argument)
 #endif
     });
     if(rankWorld != 0)
@@ -64,31 +66,86 @@ int main(int argc, char** argv) {
     K* f, *sol;
     HPDDM::underlying_type<K>* d = nullptr;
     int ndof;
-    generate(rankWorld, sizeWorld, o, mapping, ndof, Mat, MatNeumann, d, f, sol);
 #ifdef HPDDM_FROMFILE
+    const int algebraic = 0;
     int mu = 1;
 #else
+    const int algebraic = sizeWorld > 1 && opt.app().find("algebraic_overlap") != opt.app().cend() ? opt.app()["algebraic_overlap"] : 0;
     int mu = opt.app()["generate_random_rhs"];
 #endif
+    if(!algebraic)
+        generate(rankWorld, sizeWorld, o, mapping, ndof, Mat, MatNeumann, d, f, sol);
     int status = 0;
     if(sizeWorld > 1) {
         /*# Creation #*/
         HPDDM::Schwarz<SUBDOMAIN, COARSEOPERATOR, symCoarse, K> A;
         /*# CreationEnd #*/
         /*# Initialization #*/
-        A.Subdomain::initialize(Mat, o, mapping);
-        decltype(mapping)().swap(mapping);
-        A.multiplicityScaling(d);
-        A.initialize(d);
-        if(mu != 0)
-            A.scaledExchange<true>(f, mu);
-        else
-            mu = 1;
+        if(algebraic) {
+#ifndef HPDDM_FROMFILE
+            int first;
+            std::vector<HPDDM::underlying_type<K>> coordinates;
+            generateRows(rankWorld, sizeWorld, first, Mat, coordinates);
+            if(algebraic == 2) {
+                std::vector<int> origin;
+                HPDDM::MatrixCSR<K>* rows = Mat;
+                A.repartition(Mat, first, origin, &coordinates, 2);
+                delete rows;
+            }
+            const bool sym = opt.app().find("symmetric_csr") != opt.app().cend() && (opt.app()["symmetric_csr"] == 1);
+            const bool smooth = opt.app().find("smooth_partition") != opt.app().cend() && (opt.app()["smooth_partition"] == 1);
+            std::vector<int> numbering;
+            A.buildOverlap(Mat, first, opt.app()["overlap"], d, smooth, sym, nullptr, &numbering);
+            ndof = A.getDof();
+            A.initialize(d);
+            {
+                // the distributed product must match the product with the global matrix on the local rows
+                constexpr int shift = (HPDDM_NUMBERING == 'F');
+                K* const x = new K[2 * ndof];
+                for(int i = 0; i < ndof; ++i)
+                    x[i] = std::cos(numbering[i]);
+                bool allocate = A.setBuffer();
+                A.GMV(x, x + ndof);
+                A.clearBuffer(allocate);
+                HPDDM::underlying_type<K> error[2] = { 0.0, 0.0 };
+                for(int i = 0; i < ndof; ++i) {
+                    const int row = numbering[i] - first;
+                    if(row >= 0 && row < Mat->_n) {
+                        K y = K();
+                        for(int j = Mat->_ia[row] - shift; j < Mat->_ia[row + 1] - shift; ++j)
+                            y += Mat->_a[j] * HPDDM::underlying_type<K>(std::cos(Mat->_ja[j] - shift));
+                        error[0] = std::max(error[0], std::abs(y - x[ndof + i]));
+                        error[1] = std::max(error[1], std::abs(y));
+                    }
+                }
+                MPI_Allreduce(MPI_IN_PLACE, error, 2, HPDDM::Wrapper<K>::mpi_underlying_type(), MPI_MAX, MPI_COMM_WORLD);
+                if(rankWorld == 0)
+                    std::cout << " --- matrix-vector product error = " << std::scientific << error[0] << " / " << error[1] << std::endl;
+                if(error[0] > 1.0e-4 * error[1])
+                    status = 1;
+                delete [] x;
+            }
+            delete Mat;
+            generateRhs(numbering, first, ndof, coordinates, f, sol);
+            bool allocate = A.setBuffer();
+            A.exchange(f, std::max(1, mu)); // only the owners of the unknowns hold nonzero values
+            A.clearBuffer(allocate);
+#endif
+        }
+        else {
+            A.Subdomain::initialize(Mat, o, mapping);
+            decltype(mapping)().swap(mapping);
+            A.multiplicityScaling(d);
+            A.initialize(d);
+            if(mu != 0)
+                A.scaledExchange<true>(f, mu);
+        }
+        mu = std::max(1, mu);
         /*# InitializationEnd #*/
         if(opt.set("schwarz_coarse_correction")) {
             /*# Factorization #*/
             unsigned short nu = opt["geneo_nu"];
-            if(nu > 0) {
+            if(nu > 0 && MatNeumann) {
                 if(opt.app().find("nonuniform") != opt.app().cend())
                     nu += std::max(static_cast<int>(-opt["geneo_nu"] + 1), HPDDM::pow(-1, rankWorld) * rankWorld);
                 HPDDM::underlying_type<K> threshold = std::max(0.0, opt.val("geneo_threshold"));
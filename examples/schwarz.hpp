@@ -66,5 +66,8 @@ const char symCoarse = 'S';
 const HPDDM::underlying_type<K> pi = 3.141592653589793238463;
 
 void generate(int, int, std::list<int>&, std::vector<std::vector<int>>&, int&, HPDDM::MatrixCSR<K>*&, HPDDM::MatrixCSR<K>*&, HPDDM::underlying_type<K>*&, K*&, K*&);
+HPDDM::underlying_type<K> source(HPDDM::underlying_type<K>, HPDDM::underlying_type<K>);
+void generateRows(int, int, int&, HPDDM::MatrixCSR<K>*&, std::vector<HPDDM::underlying_type<K>>&);
+void generateRhs(const std::vector<int>&, int, int, const std::vector<HPDDM::underlying_type<K>>&, K*&, K*&);
 
 #endif // _SCHWARZ_
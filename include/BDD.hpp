@@ -57,14 +57,14 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             super::template initialize<false>();
             _m = new underlying_type<K>[Subdomain<K>::_dof];
         }
-        void allocateSingle(K*& primal) const {
-            primal = new K[Subdomain<K>::_dof];
+        void allocateSingle(K*& primal, const unsigned short& mu = 1) const {
+            primal = new K[mu * Subdomain<K>::_dof];
         }
         template<unsigned short N>
-        void allocateArray(K* (&array)[N]) const {
-            *array = new K[N * Subdomain<K>::_dof];
+        void allocateArray(K* (&array)[N], const unsigned short& mu = 1) const {
+            *array = new K[N * mu * Subdomain<K>::_dof];
             for(unsigned short i = 1; i < N; ++i)
-                array[i] = *array + i * Subdomain<K>::_dof;
+                array[i] = *array + i * mu * Subdomain<K>::_dof;
         }
         /* Function: buildScaling
          *
@@ -107,58 +107,87 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    f              - Right-hand side.
          *    x              - Solution vector.
          *    b              - Condensed right-hand side.
-         *    r              - First residual. */
+         *    r              - First residual.
+         *    mu             - Number of right-hand sides. */
         template<bool excluded>
-        bool start(const K* const f, K* const x, K* const b, K* r) const {
+        bool start(const K* const f, K* const x, K* const b, K* r, const unsigned short& mu = 1) const {
             bool allocate = Subdomain<K>::setBuffer();
+            const int ld = excluded ? 0 : Subdomain<K>::_a->_n;
+            K* const g = b ? b : r;
+            if(!excluded) {
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    super::condensateEffort(f + nu * ld, g + nu * Subdomain<K>::_dof);
+                Subdomain<K>::exchange(g, mu);
+            }
             if(super::_co) {
-                super::start();
+                super::start(mu);
                 if(!excluded) {
-                    super::condensateEffort(f, b);
-                    Subdomain<K>::exchange(b ? b : super::_structure + super::_bi->_m);
+                    K* w = new K[mu * Subdomain<K>::_dof];
                     if(super::_ev) {
-                        std::copy_n(b ? b : super::_structure + super::_bi->_m, Subdomain<K>::_dof, x);
-                        Wrapper<K>::diag(Subdomain<K>::_dof, _m, x);
-                        if(super::_schur) {
-                            Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), x, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), x, &i__1);
+                        for(unsigned short nu = 0; nu < mu; ++nu) {
+                            K* const wc = w + nu * Subdomain<K>::_dof;
+                            K* const uc = super::_uc + nu * *super::_co->getAddrLocal();
+                            Wrapper<K>::diag(Subdomain<K>::_dof, _m, g + nu * Subdomain<K>::_dof, wc);
+                            if(super::_schur)
+                                Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), wc, &i__1, &(Wrapper<K>::d__0), uc, &i__1);
+                            else
+                                Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), wc, &i__1, &(Wrapper<K>::d__0), uc, &i__1);
                         }
-                        else {
-                            Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), x, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__0), x, &i__1);
+                        super::_co->template callSolver<excluded>(super::_uc, mu);
+                        for(unsigned short nu = 0; nu < mu; ++nu) {
+                            K* const wc = w + nu * Subdomain<K>::_dof;
+                            const K* const uc = super::_uc + nu * *super::_co->getAddrLocal();
+                            if(super::_schur)
+                                Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), uc, &i__1, &(Wrapper<K>::d__0), wc, &i__1);
+                            else
+                                Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), uc, &i__1, &(Wrapper<K>::d__0), wc, &i__1);
+                            Wrapper<K>::diag(Subdomain<K>::_dof, _m, wc);
                         }
-                        Wrapper<K>::diag(Subdomain<K>::_dof, _m, x);
                     }
                     else {
-                        std::fill_n(x, Subdomain<K>::_dof, K());
-                        super::_co->template callSolver<excluded>(super::_uc);
+                        std::fill_n(w, mu * Subdomain<K>::_dof, K());
+                        super::_co->template callSolver<excluded>(super::_uc, mu);
                     }
-                    Subdomain<K>::exchange(x);
-                    super::applyLocalSchurComplement(x, r);
-                    Subdomain<K>::exchange(r);
-                    Blas<K>::axpby(Subdomain<K>::_dof, Wrapper<K>::d__1, b ? b : super::_structure + super::_bi->_m, 1, Wrapper<K>::d__2, r, 1);
+                    Subdomain<K>::exchange(w, mu);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        std::copy_n(w + nu * Subdomain<K>::_dof, Subdomain<K>::_dof, x + nu * ld);
+                    super::applyLocalSchurComplement(w, mu);
+                    Subdomain<K>::exchange(w, mu);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        Blas<K>::axpby(Subdomain<K>::_dof, Wrapper<K>::d__1, g + nu * Subdomain<K>::_dof, 1, Wrapper<K>::d__2, w + nu * Subdomain<K>::_dof, 1);
+                    std::copy_n(w, mu * Subdomain<K>::_dof, r);
+                    delete [] w;
                 }
                 else
-                    super::_co->template callSolver<excluded>(super::_uc);
+                    super::_co->template callSolver<excluded>(super::_uc, mu);
             }
             else if(!excluded) {
-                super::condensateEffort(f, r);
-                Subdomain<K>::exchange(r);
-                std::fill_n(x, Subdomain<K>::_dof, K());
+                if(b)
+                    std::copy_n(b, mu * Subdomain<K>::_dof, r);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::fill_n(x + nu * ld, Subdomain<K>::_dof, K());
             }
             return allocate;
         }
         /* Function: apply
          *
-         *  Applies the global Schur complement to a single right-hand side.
+         *  Applies the global Schur complement to one or multiple right-hand sides.
          *
          * Parameters:
-         *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        void apply(K* const in, K* const out = nullptr) const {
-            if(out) {
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
+        void apply(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
+            if(mu > 1) {
+                const int n = mu;
+                K* tmp = new K[mu * Subdomain<K>::_dof];
+                std::copy_n(in, mu * Subdomain<K>::_dof, tmp);
+                super::applyLocalSchurComplement(tmp, n);
+                std::copy_n(tmp, mu * Subdomain<K>::_dof, out ? out : in);
+                delete [] tmp;
+                Subdomain<K>::exchange(out ? out : in, mu);
+            }
+            else if(out) {
                 super::applyLocalSchurComplement(in, out);
                 Subdomain<K>::exchange(out);
             }
@@ -169,19 +198,45 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         }
         /* Function: precond
          *
-         *  Applies the global preconditioner to a single right-hand side.
+         *  Applies the global preconditioner to one or multiple right-hand sides.
          *
          * Parameters:
-         *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        void precond(K* const in, K* const out = nullptr) const {
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
+        void precond(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
+            if(mu > 1) {
+                K* const work = new K[mu * Subdomain<K>::_a->_n];
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    Wrapper<K>::diag(Subdomain<K>::_dof, _m, in + nu * Subdomain<K>::_dof, work + nu * Subdomain<K>::_a->_n + super::_bi->_m);
+                if(!HPDDM_QR || !super::_schur) {
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        std::fill_n(work + nu * Subdomain<K>::_a->_n, super::_bi->_m, K());
+                    static_cast<Solver<K>*>(super::_pinv)->solve(work, mu);
+                }
+                else {
+                    if(super::_deficiency && super::_fixed.empty())
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            static_cast<QR<K>*>(super::_pinv)->solve(work + nu * Subdomain<K>::_a->_n + super::_bi->_m);
+                    else {
+                        int info;
+                        const int n = mu;
+                        Lapack<K>::potrs("L", &(Subdomain<K>::_dof), &n, static_cast<const K*>(super::_pinv), &(Subdomain<K>::_dof), work + super::_bi->_m, &(Subdomain<K>::_a->_n), &info);
+                    }
+                }
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    Wrapper<K>::diag(Subdomain<K>::_dof, _m, work + nu * Subdomain<K>::_a->_n + super::_bi->_m, (out ? out : in) + nu * Subdomain<K>::_dof);
+                delete [] work;
+                Subdomain<K>::exchange(out ? out : in, mu);
+                return;
+            }
             Wrapper<K>::diag(Subdomain<K>::_dof, _m, in, super::_work + super::_bi->_m);
             if(!HPDDM_QR || !super::_schur) {
                 std::fill_n(super::_work, super::_bi->_m, K());
                 static_cast<Solver<K>*>(super::_pinv)->solve(super::_work);
             }
             else {
-                if(super::_deficiency)
+                if(super::_deficiency && super::_fixed.empty())
                     static_cast<QR<K>*>(super::_pinv)->solve(super::_work + super::_bi->_m);
                 else {
                     int info;
@@ -201,16 +256,27 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *  Factorizes <Subdomain::a> or <Schur::schur> if available. */
         void callNumfact() {
             if(HPDDM_QR && super::_schur) {
+                if(Option::get()->set(super::prefix("substructuring_kernel_tol")))
+                    super::computeKernel();
                 delete super::_bb;
                 super::_bb = nullptr;
-                if(super::_deficiency) {
-                    super::_pinv = new QR<K>(Subdomain<K>::_dof, super::_schur);
+                if(super::_deficiency && super::_fixed.empty()) {
+                    if(super::_tiles.empty())
+                        super::_pinv = new QR<K>(Subdomain<K>::_dof, super::_schur);
+                    else {
+                        K* const schur = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
+                        super::expandSchurComplement(schur);
+                        super::_pinv = new QR<K>(Subdomain<K>::_dof, schur);
+                        delete [] schur;
+                    }
                     QR<K>* qr = static_cast<QR<K>*>(super::_pinv);
                     qr->decompose();
                 }
                 else {
                     super::_pinv = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
-                    Blas<K>::lacpy("L", &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), super::_schur, &(Subdomain<K>::_dof), static_cast<K*>(super::_pinv), &(Subdomain<K>::_dof));
+                    super::expandSchurComplement(static_cast<K*>(super::_pinv));
+                    for(const int& i : super::_fixed)
+                        static_cast<K*>(super::_pinv)[i * (Subdomain<K>::_dof + 1)] += HPDDM_PEN;
                     int info;
                     Lapack<K>::potrf("L", &(Subdomain<K>::_dof), static_cast<K*>(super::_pinv), &(Subdomain<K>::_dof), &info);
                 }
@@ -227,11 +293,53 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    trans          - 'T' if the transposed projection should be applied, 'N' otherwise.
          *
          * Parameters:
-         *    in             - Input vector.
-         *    out            - Output vector (optional). */
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
         template<bool excluded, char trans>
-        void project(K* const in, K* const out = nullptr) const {
+        void project(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
             static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            if(mu > 1) {
+                if(super::_co) {
+                    if(!excluded) {
+                        const int n = mu * Subdomain<K>::_dof;
+                        K* const work = new K[n];
+                        if(trans == 'N')
+                            apply(in, work, mu);
+                        if(super::_ev) {
+                            if(trans == 'N')
+                                Wrapper<K>::diag(Subdomain<K>::_dof, _m, work, mu);
+                            else
+                                Wrapper<K>::diag(Subdomain<K>::_dof, _m, in, work, mu);
+                            const int tmp = mu;
+                            const int* const ld = super::_schur ? &(Subdomain<K>::_dof) : &(Subdomain<K>::_a->_n);
+                            const K* const ev = *super::_ev + (super::_schur ? 0 : super::_bi->_m);
+                            Blas<K>::gemm(&(Wrapper<K>::transc), "N", super::_co->getAddrLocal(), &tmp, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), ev, ld, work, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, super::_co->getAddrLocal());
+                            super::_co->template callSolver<excluded>(super::_uc, mu);
+                            Blas<K>::gemm("N", "N", &(Subdomain<K>::_dof), &tmp, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), ev, ld, super::_uc, super::_co->getAddrLocal(), &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+                        }
+                        else {
+                            super::_co->template callSolver<excluded>(super::_uc, mu);
+                            std::fill_n(work, n, K());
+                        }
+                        Wrapper<K>::diag(Subdomain<K>::_dof, _m, work, mu);
+                        Subdomain<K>::exchange(work, mu);
+                        if(trans == 'T')
+                            apply(work, nullptr, mu);
+                        if(out)
+                            for(unsigned int i = 0; i < n; ++i)
+                                out[i] = in[i] - work[i];
+                        else
+                            Blas<K>::axpy(&n, &(Wrapper<K>::d__2), work, &i__1, in, &i__1);
+                        delete [] work;
+                    }
+                    else
+                        super::_co->template callSolver<excluded>(super::_uc, mu);
+                }
+                else if(!excluded && out)
+                    std::copy_n(in, mu * Subdomain<K>::_dof, out);
+                return;
+            }
             if(super::_co) {
                 if(!excluded) {
                     if(trans == 'N')
@@ -296,23 +404,27 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    f              - Right-hand side.
-         *    x              - Solution vector. */
+         *    x              - Solution vector.
+         *    mu             - Number of right-hand sides. */
         template<bool excluded>
-        void computeSolution(const K* const f, K* const x) const {
-            if(!excluded && super::_bi->_m) {
+        void computeSolution(const K* const f, K* const x, const unsigned short& mu = 1) const {
+            if(mu > 1)
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    computeSolution<excluded>(f + (excluded ? 0 : nu * Subdomain<K>::_a->_n), x + (excluded ? 0 : nu * Subdomain<K>::_a->_n));
+            else if(!excluded && super::_bi->_m) {
                 std::copy_n(f, super::_bi->_m, x);
                 Wrapper<K>::template csrmv<Wrapper<K>::I>(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, x + super::_bi->_m, &(Wrapper<K>::d__1), x);
                 if(!super::_schur)
-                    super::_s.solve(x);
+                    super::solveInterior(x);
                 else {
                     std::copy_n(x, super::_bi->_m, super::_structure);
-                    super::_s.solve(super::_structure);
+                    super::solveInterior(super::_structure);
                     std::copy_n(super::_structure, super::_bi->_m, x);
                 }
             }
         }
         template<bool>
-        void computeSolution(K* const* const, K* const) const { }
+        void computeSolution(K* const* const, K* const, const unsigned short& = 1) const { }
         /* Function: computeDot
          *
          *  Computes the dot product of two vectors.
@@ -321,17 +433,21 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *
          * Parameters:
+         *    val            - Dot products, one per pair of vectors.
          *    a              - Left-hand side.
-         *    b              - Right-hand side. */
+         *    b              - Right-hand side.
+         *    comm           - Global MPI communicator.
+         *    mu             - Number of vectors. */
         template<bool excluded>
-        void computeDot(underlying_type<K>* const val, const K* const a, const K* const b, const MPI_Comm& comm) const {
-            if(!excluded) {
-                Wrapper<K>::diag(Subdomain<K>::_dof, _m, a, super::_work);
-                *val = std::real(Blas<K>::dot(&(Subdomain<K>::_dof), super::_work, &i__1, b, &i__1));
-            }
+        void computeDot(underlying_type<K>* const val, const K* const a, const K* const b, const MPI_Comm& comm, const unsigned short& mu = 1) const {
+            if(!excluded)
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    Wrapper<K>::diag(Subdomain<K>::_dof, _m, a + nu * Subdomain<K>::_dof, super::_work);
+                    val[nu] = std::real(Blas<K>::dot(&(Subdomain<K>::_dof), super::_work, &i__1, b + nu * Subdomain<K>::_dof, &i__1));
+                }
             else
-                *val = 0.0;
-            MPI_Allreduce(MPI_IN_PLACE, val, 1, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+                std::fill_n(val, mu, 0.0);
+            MPI_Allreduce(MPI_IN_PLACE, val, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
         }
         /* Function: getScaling
          *  Returns a constant pointer to <Bdd::m>. */
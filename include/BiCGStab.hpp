@@ -0,0 +1,179 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): agent <agent@local>
+        Date: 2026-10-18
+
+   Copyright (C) 2016-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_BICGSTAB_
+#define _HPDDM_BICGSTAB_
+
+#include "iterative.hpp"
+
+namespace HPDDM {
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::BiCGStab(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short m[2];
+    char id[2];
+    options<7>(snapshot(A), &tol, nullptr, m, id);
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = mu * n;
+    const int l = m[1];
+    const int ldz = l + 1;
+    K* const r = new K[(2 * l + 6) * dim + mu * (3 + std::max(2, ldz * ldz))];
+    K* const u = r + ldz * dim;
+    K* const rt = u + ldz * dim;
+    K* const y = rt + dim;
+    K* const z = y + dim;
+    K* const w = z + dim;
+    K* const rho = w + dim;
+    K* const alpha = rho + mu;
+    K* const omega = alpha + mu;
+    K* const dots = omega + mu;
+    underlying_type<K>* const norm = new underlying_type<K>[mu];
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -m[0]);
+    auto op = [&](const K* const in, K* const out) {
+        if(id[1] == 0) {
+            if(!excluded)
+                A.GMV(in, z, mu);
+            A.template apply<excluded>(z, out, mu);
+        }
+        else {
+            A.template apply<excluded>(in, z, mu, w);
+            if(!excluded)
+                A.GMV(z, out, mu);
+        }
+    };
+    bool allocate = initializeNorm<excluded>(A, id[1], b, x, r, n, z, norm, mu, 1);
+    if(!excluded)
+        A.GMV(x, z, mu);
+    Blas<K>::axpby(dim, 1.0, b, 1, -1.0, z, 1);
+    if(id[1] == 0)
+        A.template apply<excluded>(z, r, mu);
+    else
+        std::copy_n(z, dim, r);
+    std::copy_n(r, dim, rt);
+    std::fill_n(u, dim, K());
+    std::fill_n(y, dim, K());
+    std::fill_n(rho, mu, K(1.0));
+    std::fill_n(alpha, mu, K());
+    std::fill_n(omega, mu, K(1.0));
+    MPI_Allreduce(MPI_IN_PLACE, norm, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    for(unsigned short nu = 0; nu < mu; ++nu) {
+        norm[nu] = std::sqrt(norm[nu]);
+        if(norm[nu] < HPDDM_EPS)
+            norm[nu] = 1.0;
+    }
+    K* const xs = id[1] == 0 ? x : y;
+    unsigned short i = 0;
+    bool converged = false;
+    while(!converged && i < m[0]) {
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            rho[nu] *= -omega[nu];
+        for(unsigned short j = 0; j < l && i < m[0]; ++j) {
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                dots[nu] = Blas<K>::dot(&n, rt + nu * n, &i__1, r + j * dim + nu * n, &i__1);
+                dots[mu + nu] = Blas<K>::dot(&n, r + nu * n, &i__1, r + nu * n, &i__1);
+            }
+            MPI_Allreduce(MPI_IN_PLACE, dots, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                dots[mu + nu] = std::sqrt(std::real(dots[mu + nu]));
+            checkConvergence<7>(id[0], i, i, tol, mu, norm, dots + mu, hasConverged, m[0]);
+            if(std::find(hasConverged, hasConverged + mu, -m[0]) == hasConverged + mu) {
+                converged = true;
+                break;
+            }
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(hasConverged[nu] == -m[0] && std::abs(rho[nu]) < std::numeric_limits<underlying_type<K>>::min()) {
+                    if(id[0])
+                        std::cout << "WARNING -- BiCGStab breakdown for rhs #" << nu + 1 << " after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                    hasConverged[nu] = i;
+                }
+                const K beta = hasConverged[nu] == -m[0] ? alpha[nu] * dots[nu] / rho[nu] : K();
+                rho[nu] = dots[nu];
+                if(!excluded && n)
+                    for(unsigned short k = 0; k <= j; ++k)
+                        Blas<K>::axpby(n, 1.0, r + k * dim + nu * n, 1, -beta, u + k * dim + nu * n, 1);
+            }
+            op(u + j * dim, u + (j + 1) * dim);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                dots[nu] = Blas<K>::dot(&n, rt + nu * n, &i__1, u + (j + 1) * dim + nu * n, &i__1);
+            MPI_Allreduce(MPI_IN_PLACE, dots, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(hasConverged[nu] == -m[0] && std::abs(dots[nu]) < std::numeric_limits<underlying_type<K>>::min()) {
+                    if(id[0])
+                        std::cout << "WARNING -- BiCGStab breakdown for rhs #" << nu + 1 << " after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                    hasConverged[nu] = i;
+                }
+                alpha[nu] = hasConverged[nu] == -m[0] ? rho[nu] / dots[nu] : K();
+                K beta = -alpha[nu];
+                for(unsigned short k = 0; k <= j; ++k)
+                    Blas<K>::axpy(&n, &beta, u + (k + 1) * dim + nu * n, &i__1, r + k * dim + nu * n, &i__1);
+                Blas<K>::axpy(&n, alpha + nu, u + nu * n, &i__1, xs + nu * n, &i__1);
+            }
+            op(r + j * dim, r + (j + 1) * dim);
+            ++i;
+        }
+        if(converged)
+            break;
+        if(!excluded && n)
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &ldz, &ldz, &n, &(Wrapper<K>::d__1), r + nu * n, &dim, r + nu * n, &dim, &(Wrapper<K>::d__0), dots + nu * ldz * ldz, &ldz);
+        else
+            std::fill_n(dots, mu * ldz * ldz, K());
+        MPI_Allreduce(MPI_IN_PLACE, dots, mu * ldz * ldz, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            K* const Z = dots + nu * ldz * ldz;
+            K* const gamma = Z + 1;
+            int info;
+            Lapack<K>::potrf("U", &l, Z + 1 + ldz, &ldz, &info);
+            const int q = info > 0 ? info - 1 : l;
+            if(q > 0)
+                Lapack<K>::potrs("U", &q, &i__1, Z + 1 + ldz, &ldz, gamma, &ldz, &info);
+            std::fill(gamma + q, gamma + l, K());
+            if(hasConverged[nu] != -m[0])
+                std::fill_n(gamma, l, K());
+            omega[nu] = gamma[l - 1];
+            if(hasConverged[nu] == -m[0] && std::abs(omega[nu]) < std::numeric_limits<underlying_type<K>>::min()) {
+                if(id[0])
+                    std::cout << "WARNING -- BiCGStab breakdown for rhs #" << nu + 1 << " after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                hasConverged[nu] = i;
+                omega[nu] = K(1.0);
+            }
+            if(!excluded && n) {
+                Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__1), r + nu * n, &dim, gamma, &i__1, &(Wrapper<K>::d__1), xs + nu * n, &i__1);
+                Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__2), r + dim + nu * n, &dim, gamma, &i__1, &(Wrapper<K>::d__1), r + nu * n, &i__1);
+                Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__2), u + dim + nu * n, &dim, gamma, &i__1, &(Wrapper<K>::d__1), u + nu * n, &i__1);
+            }
+        }
+    }
+    if(id[1] != 0) {
+        A.template apply<excluded>(y, z, mu);
+        Blas<K>::axpy(&dim, &(Wrapper<K>::d__1), z, &i__1, x, &i__1);
+    }
+    convergence<7>(id[0], converged ? i : m[0] + 1, m[0]);
+    delete [] hasConverged;
+    delete [] norm;
+    delete [] r;
+    A.end(allocate);
+    return std::min(i, m[0]);
+}
+} // HPDDM
+#endif // _HPDDM_BICGSTAB_
@@ -33,11 +33,10 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
     unsigned short it;
     char id[2];
     {
-        const std::string prefix = A.prefix();
-        const Option& opt = *Option::get();
-        if(opt.any_of(prefix + "schwarz_method", { 0, 1, 4 }) || opt.any_of(prefix + "schwarz_coarse_correction", { 0 }))
+        const OptionsSnapshot& opt = snapshot(A);
+        if(opt.schwarz_method == 0 || opt.schwarz_method == 1 || opt.schwarz_method == 4 || opt.schwarz_method == 6 || opt.schwarz_coarse_correction == 0)
             return GMRES<excluded>(A, b, x, mu, comm);
-        options<2>(prefix, &tol, nullptr, &it, id);
+        options<2>(opt, &tol, nullptr, &it, id);
     }
     const int n = excluded ? 0 : A.getDof();
     const int dim = n * mu;
@@ -64,6 +63,8 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
         dir[nu] = std::real(Blas<K>::dot(&n, trash + n * nu, &i__1, p + n * nu, &i__1));
     MPI_Allreduce(MPI_IN_PLACE, dir, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
     std::transform(dir, dir + mu, res, [](const underlying_type<K>& d) { return std::sqrt(d); });
+    if(snapshot(A).initial_guess)
+        referenceNorm<excluded>(A, b, n, false, res, mu, 1, comm);
 
     int i = 0;
     while(i < it) {
@@ -149,14 +150,13 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
     unsigned short m[2];
     char id[2];
     {
-        const std::string prefix = A.prefix();
-        const Option& opt = *Option::get();
-        if(opt.any_of(prefix + "schwarz_method", { 0, 1, 4 }) || opt.any_of(prefix + "schwarz_coarse_correction", { 0 }))
+        const OptionsSnapshot& opt = snapshot(A);
+        if(opt.schwarz_method == 0 || opt.schwarz_method == 1 || opt.schwarz_method == 4 || opt.schwarz_method == 6 || opt.schwarz_coarse_correction == 0)
             return GMRES<excluded>(A, b, x, mu, comm);
-        options<3>(prefix, &tol, nullptr, m, id);
-        if(opt.val<char>(prefix + "variant", 0) == 2)
+        options<3>(opt, &tol, nullptr, m, id);
+        if(opt.variant == 2)
             return CG<excluded>(A, b, x, mu, comm);
-        m[1] = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 1);
+        m[1] = opt.enlarge;
     }
     const int n = excluded ? 0 : A.getDof();
     const int dim = n * mu;
@@ -205,6 +205,8 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
             Blas<K>::axpy(&(info = nu + 1), &(Wrapper<K>::d__1), gamma + mu * nu, &i__1, z, &i__1);
         *norm = Blas<K>::nrm2(&(info = m[1]), z, &i__1);
     }
+    if(snapshot(A).initial_guess)
+        referenceNorm<excluded>(A, b, n, false, norm, mu, m[1], comm);
     unsigned short i = 1;
     while(i <= m[0]) {
         if(!excluded) {
@@ -290,104 +292,270 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
     return std::min(i, m[0]);
 }
 template<bool excluded, class Operator, class K>
-inline int IterativeMethod::PCG(const Operator& A, const K* const f, K* const x, const MPI_Comm& comm) {
+inline int IterativeMethod::ECG(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short m[1];
+    char id[1];
+    {
+        const OptionsSnapshot& opt = snapshot(A);
+        if(opt.enlarge < 2 || opt.enlarge != mu || opt.variant == 2)
+            return BCG<excluded>(A, b, x, mu, comm);
+        if(opt.schwarz_method == 0 || opt.schwarz_method == 1 || opt.schwarz_method == 4 || opt.schwarz_method == 6 || opt.schwarz_coarse_correction == 0)
+            return GMRES<excluded>(A, b, x, mu, comm);
+        options<12>(opt, &tol, nullptr, m, id);
+    }
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = n * mu;
+    K* const r = new K[6 * dim + 3 * mu * mu + 1];
+    K* z = r + dim;
+    K* az = z + dim;
+    K* p = az + dim;
+    K* ap = p + dim;
+    K* const trash = ap + dim;
+    K* const G = trash + dim;
+    K* const beta = G + 2 * mu * mu;
+    underlying_type<K>* const workpiv = new underlying_type<K>[2 * mu];
+    int* const piv = new int[mu];
+    const underlying_type<K>* const d = A.getScaling();
+    bool allocate = A.template start<excluded>(b, x, mu);
+    if(!excluded) {
+        for(unsigned short nu = 1; nu < mu; ++nu)
+            Blas<K>::axpy(&n, &(Wrapper<K>::d__1), x + nu * n, &i__1, x, &i__1);
+        std::fill(x + n, x + dim, K());
+        A.GMV(x, r, 1);
+        Blas<K>::scal(&n, &(Wrapper<K>::d__2), r, &i__1);
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            Blas<K>::axpy(&n, &(Wrapper<K>::d__1), b + nu * n, &i__1, r, &i__1);
+        std::copy(b + n, b + dim, r + n);
+    }
+    const bool guess = snapshot(A).initial_guess;
+    underlying_type<K> norm;
+    if(guess)
+        referenceNorm<excluded>(A, b, n, false, &norm, mu, mu, comm);
+    K res;
+    short hasConverged = -m[0];
+    int t = mu;
+    int s = 0;
+    int info;
+    unsigned short i = 0;
+    while(true) {
+        A.template apply<excluded>(r, z, t, trash);
+        Wrapper<K>::diag(n, d, z, trash, t);
+        if(!excluded && n) {
+            if(s)
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &s, &t, &n, &(Wrapper<K>::d__1), ap, &n, trash, &n, &(Wrapper<K>::d__0), beta, &s);
+            beta[s * t] = Blas<K>::dot(&n, z, &i__1, trash, &i__1);
+        }
+        else
+            std::fill_n(beta, s * t + 1, K());
+        MPI_Allreduce(MPI_IN_PLACE, beta, s * t + 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        res = std::sqrt(std::real(beta[s * t]));
+        if(i == 0 && !guess) {
+            norm = std::real(res);
+            if(norm < HPDDM_EPS)
+                norm = 1.0;
+        }
+        checkConvergence<12>(id[0], i, i, tol, 1, &norm, &res, &hasConverged, m[0]);
+        if(hasConverged != -m[0] || i >= m[0])
+            break;
+        if(!excluded) {
+            if(s && n)
+                Blas<K>::gemm("N", "N", &n, &t, &s, &(Wrapper<K>::d__2), p, &n, beta, &s, &(Wrapper<K>::d__1), z, &n);
+            A.GMV(z, az, t);
+        }
+        Wrapper<K>::diag(n, d, z, trash, t);
+        K* const F = G + t * t;
+        if(!excluded && n) {
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &t, &t, &n, &(Wrapper<K>::d__1), trash, &n, az, &n, &(Wrapper<K>::d__0), G, &t);
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &t, &t, &n, &(Wrapper<K>::d__1), trash, &n, r, &n, &(Wrapper<K>::d__0), F, &t);
+        }
+        else
+            std::fill_n(G, 2 * t * t, K());
+        MPI_Allreduce(MPI_IN_PLACE, G, 2 * t * t, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        for(int l = 0; l < t; ++l) {
+            const underlying_type<K> g = std::real(G[l * (t + 1)]);
+            const underlying_type<K> f = std::sqrt(std::abs(std::real(F[l * (t + 1)])));
+            workpiv[l] = (g > 0.0 && (l == 0 || (tol > 0.0 ? f > tol * norm : f > -tol))) ? 1.0 / std::sqrt(g) : 0.0;
+        }
+        for(int c = 0; c < t; ++c)
+            for(int l = 0; l < t; ++l) {
+                G[l + c * t] *= workpiv[l] * workpiv[c];
+                beta[l + c * t] = workpiv[l] * F[l + c * t];
+            }
+        if(!excluded && n)
+            for(int l = 0; l < t; ++l) {
+                const K alpha = workpiv[l];
+                Blas<K>::scal(&n, &alpha, z + l * n, &i__1);
+                Blas<K>::scal(&n, &alpha, az + l * n, &i__1);
+            }
+        const underlying_type<K> threshold = std::sqrt(std::numeric_limits<underlying_type<K>>::epsilon());
+        Lapack<K>::pstrf("U", &t, G, &t, piv, &s, &threshold, workpiv, &info);
+        if(info == 0)
+            s = t;
+        if(s == 0) {
+            if(id[0])
+                std::cout << "WARNING -- ECG breakdown after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+            hasConverged = i;
+            break;
+        }
+        for(int c = 0; c < t; ++c)
+            for(int l = 0; l < s; ++l)
+                F[l + c * s] = beta[piv[l] - 1 + c * t];
+        Blas<K>::trsm("L", "U", &(Wrapper<K>::transc), "N", &s, &t, &(Wrapper<K>::d__1), G, &t, F, &s);
+        if(!excluded && n) {
+            Lapack<K>::lapmt(&i__1, &n, &t, z, &n, piv);
+            Lapack<K>::lapmt(&i__1, &n, &t, az, &n, piv);
+            Blas<K>::trsm("R", "U", "N", "N", &n, &s, &(Wrapper<K>::d__1), G, &t, z, &n);
+            Blas<K>::trsm("R", "U", "N", "N", &n, &s, &(Wrapper<K>::d__1), G, &t, az, &n);
+            Blas<K>::gemv("N", &n, &s, &(Wrapper<K>::d__1), z, &n, F, &i__1, &(Wrapper<K>::d__1), x, &i__1);
+            Blas<K>::gemm("N", "N", &n, &t, &s, &(Wrapper<K>::d__2), az, &n, F, &s, &(Wrapper<K>::d__1), r, &n);
+        }
+        std::swap(p, z);
+        std::swap(ap, az);
+        ++i;
+        if(s < t) {
+            std::remove(piv, piv + s, 1);
+            std::sort(piv, piv + s - 1);
+            if(!excluded && n)
+                for(int l = 0; l < s - 1; ++l)
+                    std::copy_n(r + (piv[l] - 1) * n, n, r + (l + 1) * n);
+            if(id[0] > 1)
+                std::cout << "ECG: " << std::setw(3) << i << " reduction to " << s << " search direction" << (s > 1 ? "s" : "") << std::endl;
+            t = s;
+        }
+    }
+    convergence<12>(id[0], hasConverged != -m[0] ? i : m[0] + 1, m[0]);
+    delete [] piv;
+    delete [] workpiv;
+    delete [] r;
+    A.end(allocate);
+    return std::min(i, m[0]);
+}
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::PCG(const Operator& A, const K* const f, K* const x, const int& mu, const MPI_Comm& comm) {
     underlying_type<K> tol;
     unsigned short it;
     char verbosity;
-    options<6>(A.prefix(), &tol, nullptr, &it, &verbosity);
+    options<6>(snapshot(A), &tol, nullptr, &it, &verbosity);
     typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
     const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
     const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
+    const int ld = std::is_same<ptr_type, K*>::value ? n : A.getMap().size();
     ptr_type storage[std::is_same<ptr_type, K*>::value ? 1 : 2];
     // storage[0] = r
     // storage[1] = lambda
-    A.allocateArray(storage);
+    A.allocateArray(storage, mu);
     auto m = A.getScaling();
-    bool allocate = std::is_same<ptr_type, K*>::value ? A.template start<excluded>(f, x + offset, nullptr, storage[0]) : A.template start<excluded>(f, x, storage[1], storage[0]);
+    bool allocate = std::is_same<ptr_type, K*>::value ? A.template start<excluded>(f, x + offset, nullptr, storage[0], mu) : A.template start<excluded>(f, x, storage[1], storage[0], mu);
     std::vector<ptr_type> z;
     z.reserve(it);
     ptr_type zCurr;
-    A.allocateSingle(zCurr);
+    A.allocateSingle(zCurr, mu);
     z.emplace_back(zCurr);
     if(!excluded)
-        A.precond(storage[0], zCurr);                                                              //     z_0 = M r_0
+        A.precond(storage[0], zCurr, mu);                                                          //     z_0 = M r_0
 
-    underlying_type<K> resInit;
-    A.template computeDot<excluded>(&resInit, zCurr, zCurr, comm);
-    resInit = std::sqrt(resInit);
+    underlying_type<K>* const resInit = new underlying_type<K>[2 * (mu + it)];
+    underlying_type<K>* const resRel = resInit + mu;
+    underlying_type<K>* const lanczos = resRel + mu;
+    A.template computeDot<excluded>(resInit, zCurr, zCurr, comm, mu);
+    std::for_each(resInit, resInit + mu, [](underlying_type<K>& r) { r = std::sqrt(r); });
 
     std::vector<ptr_type> p;
     p.reserve(it);
     ptr_type pCurr;
-    A.allocateSingle(pCurr);
+    A.allocateSingle(pCurr, mu);
     p.emplace_back(pCurr);
 
-    K* alpha = new K[excluded ? std::max(static_cast<unsigned short>(2), it) : 2 * it];
-    underlying_type<K> resRel = std::numeric_limits<underlying_type<K>>::max();
+    K* alpha = new K[mu * (excluded ? std::max(static_cast<unsigned short>(2), it) : 2 * it)];
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -it);
     unsigned short i = 1;
+    const double time = MPI_Wtime();
     while(i <= it) {
         if(!excluded) {
-            A.template project<excluded, 'N'>(zCurr, pCurr);                                       //     p_i = P z_i
+            A.template project<excluded, 'N'>(zCurr, pCurr, mu);                                   //     p_i = P z_i
             for(unsigned short k = 0; k < i - 1; ++k)
-                alpha[it + k] = dot(&n, z[k], &i__1, pCurr, &i__1);
-            MPI_Allreduce(MPI_IN_PLACE, alpha + it, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm); // alpha_k = < z_k, p_i >
-            for(unsigned short k = 0; k < i - 1; ++k) {
-                alpha[it + k] /= -alpha[k];
-                axpy(&n, alpha + it + k, p[k], &i__1, pCurr, &i__1);                               //     p_i = p_i - sum < z_k, p_i > / < z_k, p_k > p_k
-            }
-            A.apply(pCurr, zCurr);                                                                 //     z_i = F p_i
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    alpha[(it + k) * mu + nu] = dot(&n, z[k] + nu * ld, &i__1, pCurr + nu * ld, &i__1);
+            MPI_Allreduce(MPI_IN_PLACE, alpha + it * mu, (i - 1) * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm); // alpha_k = < z_k, p_i >
+            for(unsigned short k = 0; k < i - 1; ++k)
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    if(hasConverged[nu] == -it) {
+                        alpha[(it + k) * mu + nu] /= -alpha[k * mu + nu];
+                        axpy(&n, alpha + (it + k) * mu + nu, p[k] + nu * ld, &i__1, pCurr + nu * ld, &i__1); // p_i = p_i - sum < z_k, p_i > / < z_k, p_k > p_k
+                    }
+            lanczos[2 * i - 1] = (i > 1 ? std::real(alpha[(it + i - 2) * mu]) : 0.0);
+            A.apply(pCurr, zCurr, mu);                                                             //     z_i = F p_i
 
-            A.allocateSingle(zCurr);
-            if(std::is_same<ptr_type, K*>::value) {
-                diag(n, m, pCurr, zCurr);
-                alpha[i - 1] = dot(&n, z.back(), &i__1, zCurr, &i__1);
-                alpha[i]     = dot(&n, storage[0], &i__1, zCurr, &i__1);
+            A.allocateSingle(zCurr, mu);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(std::is_same<ptr_type, K*>::value) {
+                    diag(n, m, pCurr + nu * ld, zCurr + nu * ld);
+                    alpha[(i - 1) * mu + nu] = dot(&n, z.back() + nu * ld, &i__1, zCurr + nu * ld, &i__1);
+                    alpha[i * mu + nu]       = dot(&n, storage[0] + nu * ld, &i__1, zCurr + nu * ld, &i__1);
+                }
+                else {
+                    alpha[(i - 1) * mu + nu] = dot(&n, z.back() + nu * ld, &i__1, pCurr + nu * ld, &i__1);
+                    alpha[i * mu + nu]       = dot(&n, storage[0] + nu * ld, &i__1, pCurr + nu * ld, &i__1);
+                }
             }
-            else {
-                alpha[i - 1] = dot(&n, z.back(), &i__1, pCurr, &i__1);
-                alpha[i]     = dot(&n, storage[0], &i__1, pCurr, &i__1);
+            MPI_Allreduce(MPI_IN_PLACE, alpha + (i - 1) * mu, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(hasConverged[nu] == -it) {
+                    K beta = alpha[i * mu + nu] / alpha[(i - 1) * mu + nu];
+                    if(nu == 0)
+                        lanczos[2 * i - 2] = std::real(beta);
+                    if(std::is_same<ptr_type, K*>::value)
+                        axpy(&n, &beta, pCurr + nu * ld, &i__1, x + offset + nu * (offset + n), &i__1);
+                    else
+                        axpy(&n, &beta, pCurr + nu * ld, &i__1, storage[1] + nu * ld, &i__1);      // l_i + 1 = l_i + < r_i, p_i > / < z_i, p_i > p_i
+                    beta = -beta;
+                    axpy(&n, &beta, z.back() + nu * ld, &i__1, storage[0] + nu * ld, &i__1);      // r_i + 1 = r_i - < r_i, p_i > / < z_i, p_i > z_i
+                }
             }
-            MPI_Allreduce(MPI_IN_PLACE, alpha + i - 1, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
-            alpha[it] = alpha[i] / alpha[i - 1];
-            if(std::is_same<ptr_type, K*>::value)
-                axpy(&n, alpha + it, pCurr, &i__1, x + offset, &i__1);
-            else
-                axpy(&n, alpha + it, pCurr, &i__1, storage[1], &i__1);                             // l_i + 1 = l_i + < r_i, p_i > / < z_i, p_i > p_i
-            alpha[it] = -alpha[it];
-            axpy(&n, alpha + it, z.back(), &i__1, storage[0], &i__1);                              // r_i + 1 = r_i - < r_i, p_i > / < z_i, p_i > z_i
-            A.template project<excluded, 'T'>(storage[0]);                                         // r_i + 1 = P^T r_i + 1
+            A.template project<excluded, 'T'>(storage[0], nullptr, mu);                            // r_i + 1 = P^T r_i + 1
 
             z.emplace_back(zCurr);
-            A.precond(storage[0], zCurr);                                                          // z_i + 1 = M r_i
+            A.precond(storage[0], zCurr, mu);                                                      // z_i + 1 = M r_i
         }
         else {
-            A.template project<excluded, 'N'>(zCurr, pCurr);
-            std::fill_n(alpha, i - 1, K());
-            MPI_Allreduce(MPI_IN_PLACE, alpha, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
-            std::fill_n(alpha, 2, K());
-            MPI_Allreduce(MPI_IN_PLACE, alpha, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
-            A.template project<excluded, 'T'>(storage[0]);
+            A.template project<excluded, 'N'>(zCurr, pCurr, mu);
+            std::fill_n(alpha, (i - 1) * mu, K());
+            MPI_Allreduce(MPI_IN_PLACE, alpha, (i - 1) * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            std::fill_n(alpha, 2 * mu, K());
+            MPI_Allreduce(MPI_IN_PLACE, alpha, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            A.template project<excluded, 'T'>(storage[0], nullptr, mu);
         }
-        A.template computeDot<excluded>(&resRel, zCurr, zCurr, comm);
-        resRel = std::sqrt(resRel);
-        if(verbosity > 2)
-            std::cout << "PCG: " << std::setw(3) << i << " " << resRel << " " << resInit << " " << resRel / resInit << " < " << tol << std::endl;
-        if(resRel / resInit <= tol)
+        A.template computeDot<excluded>(resRel, zCurr, zCurr, comm, mu);
+        std::for_each(resRel, resRel + mu, [](underlying_type<K>& r) { r = std::sqrt(r); });
+        if(!excluded && hasConverged[0] == -it && A.adapt(lanczos, i, MPI_Wtime() - time, (tol > 0.0 ? tol * resInit[0] : -tol) / resRel[0])) {
+            A.precond(storage[0], zCurr, mu);                                                      // z_i + 1 = M r_i with the new preconditioner
+            std::transform(resInit, resInit + mu, resRel, resInit, std::divides<underlying_type<K>>());
+            A.template computeDot<excluded>(resRel, zCurr, zCurr, comm, mu);
+            std::for_each(resRel, resRel + mu, [](underlying_type<K>& r) { r = std::sqrt(r); });
+            std::transform(resInit, resInit + mu, resRel, resInit, std::multiplies<underlying_type<K>>());
+        }
+        checkConvergence<6>(verbosity, i, i, tol, mu, resInit, resRel, hasConverged, it);
+        if(std::find(hasConverged, hasConverged + mu, -it) == hasConverged + mu)
             break;
         else
             ++i;
         if(!excluded) {
-            A.allocateSingle(pCurr);
+            A.allocateSingle(pCurr, mu);
             p.emplace_back(pCurr);
-            diag(n, m, z[i - 2]);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                diag(n, m, z[i - 2] + nu * ld);
         }
     }
     convergence<6>(verbosity, i, it);
     if(std::is_same<ptr_type, K*>::value)
-        A.template computeSolution<excluded>(f, x);
+        A.template computeSolution<excluded>(f, x, mu);
     else
-        A.template computeSolution<excluded>(storage[1], x);
+        A.template computeSolution<excluded>(storage[1], x, mu);
+    delete [] hasConverged;
     delete [] alpha;
+    delete [] resInit;
     for(auto zCurr : z)
         clean(zCurr);
     for(auto pCurr : p)
@@ -49,6 +49,39 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         /* Variable: m
          *  Local partition of unity. */
         underlying_type<K>** _m;
+        /* Variable: cluster
+         *  Communicator of the cluster of subdomains of hybrid FETI, <MPI_COMM_NULL> otherwise. */
+        MPI_Comm       _cluster;
+        /* Variable: first
+         *  Index in the cluster of the first Lagrange multiplier shared with each neighbor, -1 if the neighbor does not belong to the cluster. */
+        std::vector<int> _first;
+        /* Variable: gather
+         *  Number of values, displacements, and indices in <Feti::saddle> of the values of each subdomain of the cluster (only on the root of the cluster). */
+        std::vector<int> _gather;
+        /* Variable: columns
+         *  Indices in the hybrid coarse operator of the columns of <Feti::ge>, starting with the kernel of the local cluster. */
+        std::vector<int> _columns;
+        /* Variable: saddle
+         *  Pseudo-inverse of the saddle-point system of the cluster (only on the root of the cluster). */
+        K*              _saddle;
+        /* Variable: kernel
+         *  Local rows of the basis of the kernel of the cluster. */
+        K*              _kernel;
+        /* Variable: ge
+         *  Local rows of the jump of the kernels of the clusters. */
+        K*                  _ge;
+        /* Variable: coarse
+         *  Cholesky factorization of the hybrid coarse operator. */
+        K*              _coarse;
+        /* Variable: sizes
+         *  Size of <Feti::saddle>, dimension of the kernel of the cluster, and size of the hybrid coarse operator. */
+        int            _sizes[3];
+        /* Variable: prcndtnr
+         *  <FetiPrcndtnr> applied in <IterativeMethod::PCG>, either P or <FetiPrcndtnr::DIRICHLET> after <Feti::adapt>. */
+        mutable FetiPrcndtnr _prcndtnr;
+        /* Variable: adapted
+         *  True if <Feti::adapt> has already chosen <Feti::prcndtnr>, false otherwise. */
+        mutable bool       _adapted;
         /* Function: A
          *
          *  Jump operator.
@@ -59,18 +92,49 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    primal         - Primal unknowns.
-         *    dual           - Dual unknowns. */
+         *    dual           - Dual unknowns.
+         *    mu             - Number of vectors. */
         template<char trans, bool scale>
-        void A(K* const primal, K* const* const dual) const {
+        void A(K* const primal, K* const* const dual, const unsigned short& mu = 1) const {
             static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
             if(trans == 'T') {
-                std::fill_n(primal, Subdomain<K>::_dof, K());
-                for(unsigned short i = 0; i < super::_signed; ++i)
-                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        primal[Subdomain<K>::_map[i].second[j]] -= scale ? _m[i][j] * dual[i][j] : dual[i][j];
-                for(unsigned short i = super::_signed; i < Subdomain<K>::_map.size(); ++i)
-                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        primal[Subdomain<K>::_map[i].second[j]] += scale ? _m[i][j] * dual[i][j] : dual[i][j];
+                std::fill_n(primal, mu * Subdomain<K>::_dof, K());
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    K* const p = primal + nu * Subdomain<K>::_dof;
+                    K* const* const d = dual + nu * Subdomain<K>::_map.size();
+                    for(unsigned short i = 0; i < super::_signed; ++i)
+                        for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
+                            p[Subdomain<K>::_map[i].second[j]] -= scale ? _m[i][j] * d[i][j] : d[i][j];
+                    for(unsigned short i = super::_signed; i < Subdomain<K>::_map.size(); ++i)
+                        for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
+                            p[Subdomain<K>::_map[i].second[j]] += scale ? _m[i][j] * d[i][j] : d[i][j];
+                }
+            }
+            else if(mu > 1) {
+                K* const recv = new K[2 * mu * super::_mult];
+                K* const send = recv + mu * super::_mult;
+                for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                    const int size = Subdomain<K>::_map[i].second.size();
+                    const unsigned int offset = mu * (dual[i] - *dual);
+                    MPI_Irecv(recv + offset, mu * size, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
+                    for(unsigned short nu = 0; nu < mu; ++nu) {
+                        K* const d = dual[nu * Subdomain<K>::_map.size() + i];
+                        const K* const p = primal + nu * Subdomain<K>::_dof;
+                        for(unsigned int j = 0; j < size; ++j) {
+                            const K val = scale ? _m[i][j] * p[Subdomain<K>::_map[i].second[j]] : p[Subdomain<K>::_map[i].second[j]];
+                            send[offset + nu * size + j] = d[j] = (i < super::_signed ? -val : val);
+                        }
+                    }
+                    MPI_Isend(send + offset, mu * size, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                }
+                MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
+                for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                    const int size = Subdomain<K>::_map[i].second.size();
+                    const K* const buff = recv + mu * (dual[i] - *dual);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        Blas<K>::axpy(&size, &(Wrapper<K>::d__1), buff + nu * size, &i__1, dual[nu * Subdomain<K>::_map.size() + i], &i__1);
+                }
+                delete [] recv;
             }
             else {
                 for(unsigned short i = 0; i < super::_signed; ++i) {
@@ -101,9 +165,434 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             dual = new U*[Subdomain<K>::_map.size()];
             m    = new underlying_type<U>*[Subdomain<K>::_map.size()];
         }
+        /* Function: clearInternal
+         *
+         *  Sets to zero the Lagrange multipliers shared with neighbors of the same cluster.
+         *
+         * Parameters:
+         *    dual           - Dual unknowns.
+         *    mu             - Number of vectors. */
+        void clearInternal(K* const* const dual, const unsigned short& mu = 1) const {
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                    if(_first[i] != -1)
+                        std::fill_n(dual[nu * Subdomain<K>::_map.size() + i], Subdomain<K>::_map[i].second.size(), K());
+        }
+        /* Function: applyKernel
+         *
+         *  Computes the local coefficients of a primal vector in the basis of the local kernel.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output coefficients. */
+        void applyKernel(const K* const in, K* const out) const {
+            if(super::_schur) {
+                K* const b = new K[Subdomain<K>::_dof];
+                super::condensateEffort(in, b);
+                Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), b, &i__1, &(Wrapper<K>::d__0), out, &i__1);
+                delete [] b;
+            }
+            else
+                Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_a->_n), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_a->_n), in, &i__1, &(Wrapper<K>::d__0), out, &i__1);
+        }
+        /* Function: addKernel
+         *
+         *  Adds a linear combination of the local kernel to a primal vector.
+         *
+         * Parameters:
+         *    alpha          - Coefficients.
+         *    x              - Primal vector. */
+        void addKernel(const K* const alpha, K* const x) const {
+            if(super::_schur) {
+                K* const work = new K[Subdomain<K>::_a->_n];
+                Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), alpha, &i__1, &(Wrapper<K>::d__0), work + super::_bi->_m, &i__1);
+                Wrapper<K>::template csrmv<Wrapper<K>::I>(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, work + super::_bi->_m, &(Wrapper<K>::d__0), work);
+                if(super::_bi->_m)
+                    super::solveInterior(work);
+                Blas<K>::axpy(&(Subdomain<K>::_a->_n), &(Wrapper<K>::d__1), work, &i__1, x, &i__1);
+                delete [] work;
+            }
+            else
+                Blas<K>::gemv("N", &(Subdomain<K>::_a->_n), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_a->_n), alpha, &i__1, &(Wrapper<K>::d__1), x, &i__1);
+        }
+        /* Function: solveCluster
+         *
+         *  Solves a Neumann problem on the cluster by eliminating the Lagrange multipliers shared with neighbors of the same cluster.
+         *
+         * Parameter:
+         *    x              - Input right-hand side, solution vector is stored in-place. */
+        void solveCluster(K* const x) const {
+            const int k = super::_ev ? super::getLocal() : 0;
+            int n = 0;
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                if(_first[i] != -1)
+                    n += Subdomain<K>::_map[i].second.size();
+            K* const v = new K[Subdomain<K>::_a->_n + n + k];
+            K* const buff = v + Subdomain<K>::_a->_n;
+            static_cast<Solver<K>*>(super::_pinv)->solve(x, v);                                                                               //    v = K^+ x
+            for(unsigned short i = 0, j = 0; i < Subdomain<K>::_map.size(); ++i)
+                if(_first[i] != -1)
+                    for(const int& d : Subdomain<K>::_map[i].second)
+                        buff[j++] = (i < super::_signed ? -v[super::_bi->_m + d] : v[super::_bi->_m + d]);
+            if(k)
+                applyKernel(x, buff + n);                                                                                                     // buff = [ B_I K^+ x, R^T x ]
+            int rank;
+            MPI_Comm_rank(_cluster, &rank);
+            const int m = n + k;
+            if(rank == 0) {
+                int size;
+                MPI_Comm_size(_cluster, &size);
+                const int* const counts = _gather.data();
+                const int* const idx = counts + 2 * size;
+                const int total = counts[2 * size - 1] + counts[size - 1];
+                K* const recv = new K[total + 2 * _sizes[0]];
+                K* const rhs = recv + total;
+                MPI_Gatherv(buff, m, Wrapper<K>::mpi_type(), recv, counts, counts + size, Wrapper<K>::mpi_type(), 0, _cluster);
+                std::fill_n(rhs, _sizes[0], K());
+                for(int i = 0; i < total; ++i)
+                    rhs[idx[i]] += recv[i];
+                if(_sizes[0])
+                    Blas<K>::gemv("N", _sizes, _sizes, &(Wrapper<K>::d__1), _saddle, _sizes, rhs, &i__1, &(Wrapper<K>::d__0), rhs + _sizes[0], &i__1);
+                for(int i = 0; i < total; ++i)
+                    recv[i] = rhs[_sizes[0] + idx[i]];
+                MPI_Scatterv(recv, counts, counts + size, Wrapper<K>::mpi_type(), buff, m, Wrapper<K>::mpi_type(), 0, _cluster);
+                delete [] recv;
+            }
+            else {
+                MPI_Gatherv(buff, m, Wrapper<K>::mpi_type(), nullptr, nullptr, nullptr, Wrapper<K>::mpi_type(), 0, _cluster);
+                MPI_Scatterv(nullptr, nullptr, nullptr, Wrapper<K>::mpi_type(), buff, m, Wrapper<K>::mpi_type(), 0, _cluster);
+            }
+            for(unsigned short i = 0, j = 0; i < Subdomain<K>::_map.size(); ++i)
+                if(_first[i] != -1)
+                    for(const int& d : Subdomain<K>::_map[i].second) {
+                        if(i < super::_signed)
+                            x[super::_bi->_m + d] += buff[j++];
+                        else
+                            x[super::_bi->_m + d] -= buff[j++];
+                    }
+            static_cast<Solver<K>*>(super::_pinv)->solve(x);                                                                                  //    x = K^+ (x - B_I^T mu)
+            if(k) {
+                std::for_each(buff + n, buff + m, [](K& alpha) { alpha = -alpha; });
+                addKernel(buff + n, x);                                                                                                       //    x = K^+ (x - B_I^T mu) + R alpha
+            }
+            delete [] v;
+        }
+        /* Function: solveHybrid
+         *
+         *  Solves the hybrid coarse operator.
+         *
+         * Parameters:
+         *    dual           - Dual unknowns.
+         *    y              - Solution vector of size <Feti::sizes>[2]. */
+        void solveHybrid(const K* const* const dual, K* const y) const {
+            const int ncol = _columns.size();
+            K* const tmp = new K[ncol];
+            const K half = 0.5;
+            Blas<K>::gemv(&(Wrapper<K>::transc), &(super::_mult), &ncol, &half, _ge, &(super::_mult), *dual, &i__1, &(Wrapper<K>::d__0), tmp, &i__1);
+            std::fill_n(y, _sizes[2], K());
+            for(int i = 0; i < ncol; ++i)
+                y[_columns[i]] = tmp[i];
+            delete [] tmp;
+            MPI_Allreduce(MPI_IN_PLACE, y, _sizes[2], Wrapper<K>::mpi_type(), MPI_SUM, Subdomain<K>::_communicator);
+            int info;
+            Lapack<K>::potrs("L", _sizes + 2, &i__1, _coarse, _sizes + 2, y, _sizes + 2, &info);
+        }
+        /* Function: projectHybrid
+         *
+         *  Projects a single vector orthogonally to the range of <Feti::ge>.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output vector (optional). */
+        void projectHybrid(K* const* const in, K* const* const out) const {
+            if(out)
+                std::copy_n(*in, super::_mult, *out);
+            if(_sizes[2]) {
+                const int ncol = _columns.size();
+                K* const y = new K[_sizes[2] + ncol];
+                solveHybrid(in, y);
+                for(int i = 0; i < ncol; ++i)
+                    y[_sizes[2] + i] = y[_columns[i]];
+                Blas<K>::gemv("N", &(super::_mult), &ncol, &(Wrapper<K>::d__2), _ge, &(super::_mult), y + _sizes[2], &i__1, &(Wrapper<K>::d__1), out ? *out : *in, &i__1);
+                delete [] y;
+            }
+        }
+        /* Function: buildHybrid
+         *
+         *  Factorizes the saddle-point systems of the clusters and assembles the hybrid coarse operator. */
+        void buildHybrid() {
+            delete [] _coarse;
+            delete [] _ge;
+            delete [] _kernel;
+            delete [] _saddle;
+            _coarse = _ge = _kernel = _saddle = nullptr;
+            _gather.clear();
+            const vectorNeighbor& map = Subdomain<K>::_map;
+            const MPI_Comm& comm = Subdomain<K>::_communicator;
+            MPI_Request* const rq = Subdomain<K>::_rq;
+            int rank, size;
+            MPI_Comm_rank(_cluster, &rank);
+            MPI_Comm_size(_cluster, &size);
+            std::vector<int> leader(map.size() + 1, super::_rankWorld);
+            MPI_Bcast(&leader.back(), 1, MPI_INT, 0, _cluster);
+            for(unsigned short i = 0; i < map.size(); ++i) {
+                MPI_Irecv(leader.data() + i, 1, MPI_INT, map[i].first, 1, comm, rq + i);
+                MPI_Isend(&leader.back(), 1, MPI_INT, map[i].first, 1, comm, rq + map.size() + i);
+            }
+            MPI_Waitall(2 * map.size(), rq, MPI_STATUSES_IGNORE);
+            int offset = 0, owned = 0;
+            for(unsigned short i = 0; i < map.size(); ++i)
+                if(leader[i] == leader.back() && map[i].first > super::_rankWorld)
+                    owned += map[i].second.size();
+            MPI_Exscan(&owned, &offset, 1, MPI_INT, MPI_SUM, _cluster);
+            if(rank == 0)
+                offset = 0;
+            _first.assign(map.size(), -1);
+            for(unsigned short i = 0; i < map.size(); ++i) {
+                rq[i] = rq[map.size() + i] = MPI_REQUEST_NULL;
+                if(leader[i] == leader.back()) {
+                    if(map[i].first > super::_rankWorld) {
+                        _first[i] = offset;
+                        offset += map[i].second.size();
+                        MPI_Isend(_first.data() + i, 1, MPI_INT, map[i].first, 2, comm, rq + map.size() + i);
+                    }
+                    else
+                        MPI_Irecv(_first.data() + i, 1, MPI_INT, map[i].first, 2, comm, rq + i);
+                }
+            }
+            MPI_Waitall(2 * map.size(), rq, MPI_STATUSES_IGNORE);
+            std::vector<std::pair<unsigned short, int>> internal;
+            for(unsigned short i = 0; i < map.size(); ++i)
+                if(_first[i] != -1)
+                    for(unsigned int j = 0; j < map[i].second.size(); ++j)
+                        internal.emplace_back(i, j);
+            const int k = super::_ev ? super::getLocal() : 0;
+            int n[2] = { static_cast<int>(internal.size()), k };
+            std::vector<int> idx;
+            idx.reserve(n[0]);
+            for(const std::pair<unsigned short, int>& p : internal)
+                idx.emplace_back(_first[p.first] + p.second);
+            K* const values = new K[n[0] * (n[0] + k)];
+            if(n[0]) {
+                const int block = std::min(n[0], 128);
+                K* const work = new K[block * Subdomain<K>::_a->_n];
+                for(int j = 0; j < n[0]; j += block) {
+                    const int nb = std::min(block, n[0] - j);
+                    std::fill_n(work, nb * Subdomain<K>::_a->_n, K());
+                    for(int c = 0; c < nb; ++c)
+                        work[c * Subdomain<K>::_a->_n + super::_bi->_m + map[internal[j + c].first].second[internal[j + c].second]] = (internal[j + c].first < super::_signed ? -1.0 : 1.0);
+                    static_cast<Solver<K>*>(super::_pinv)->solve(work, nb);
+                    for(int c = 0; c < nb; ++c)
+                        for(int r = 0; r < n[0]; ++r) {
+                            const K val = work[c * Subdomain<K>::_a->_n + super::_bi->_m + map[internal[r].first].second[internal[r].second]];
+                            values[r + (j + c) * n[0]] = (internal[r].first < super::_signed ? -val : val);                   // F_I = B_I K^+ B_I^T
+                        }
+                }
+                delete [] work;
+                const int ld = super::_schur ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                const K* const ev = k ? *super::_ev + (super::_schur ? 0 : super::_bi->_m) : nullptr;
+                for(int c = 0; c < k; ++c)
+                    for(int r = 0; r < n[0]; ++r) {
+                        const K val = ev[map[internal[r].first].second[internal[r].second] + c * ld];
+                        values[n[0] * n[0] + r + c * n[0]] = (internal[r].first < super::_signed ? -val : val);           // G_I = B_I R
+                    }
+            }
+            int hc = 0;
+            K* h = nullptr;
+            int* counts = nullptr;
+            if(rank == 0) {
+                std::vector<int> sizes(2 * size);
+                MPI_Gather(n, 2, MPI_INT, sizes.data(), 2, MPI_INT, 0, _cluster);
+                counts = new int[6 * size];
+                int kc = 0;
+                for(int i = 0; i < size; ++i) {
+                    counts[i] = sizes[2 * i];
+                    counts[2 * size + i] = sizes[2 * i] * (sizes[2 * i] + sizes[2 * i + 1]);
+                    counts[4 * size + i] = sizes[2 * i + 1];
+                    counts[size + i] = (i == 0 ? 0 : counts[size + i - 1] + counts[i - 1]);
+                    counts[3 * size + i] = (i == 0 ? 0 : counts[3 * size + i - 1] + counts[2 * size + i - 1]);
+                    counts[5 * size + i] = kc;
+                    kc += sizes[2 * i + 1];
+                }
+                std::vector<int> all(counts[2 * size - 1] + counts[size - 1]);
+                MPI_Gatherv(idx.data(), n[0], MPI_INT, all.data(), counts, counts + size, MPI_INT, 0, _cluster);
+                K* const recv = new K[counts[4 * size - 1] + counts[3 * size - 1]];
+                MPI_Gatherv(values, n[0] * (n[0] + k), Wrapper<K>::mpi_type(), recv, counts + 2 * size, counts + 3 * size, Wrapper<K>::mpi_type(), 0, _cluster);
+                const int mc = all.empty() ? 0 : *std::max_element(all.cbegin(), all.cend()) + 1;
+                const int N = _sizes[0] = mc + kc;
+                K* const saddle = new K[N * N]();
+                _gather.resize(2 * size + all.size() + kc);
+                for(int i = 0; i < size; ++i) {
+                    const int ni = counts[i], ki = counts[4 * size + i];
+                    const int* const id = all.data() + counts[size + i];
+                    const K* const v = recv + counts[3 * size + i];
+                    for(int c = 0; c < ni; ++c)
+                        for(int r = 0; r < ni; ++r)
+                            saddle[id[r] + id[c] * N] += v[r + c * ni];
+                    for(int c = 0; c < ki; ++c)
+                        for(int r = 0; r < ni; ++r) {
+                            saddle[id[r] + (mc + counts[5 * size + i] + c) * N] += v[ni * ni + r + c * ni];
+                            saddle[mc + counts[5 * size + i] + c + id[r] * N] += Wrapper<K>::conj(v[ni * ni + r + c * ni]);
+                        }
+                    _gather[i] = ni + ki;
+                    _gather[size + i] = (i == 0 ? 0 : _gather[size + i - 1] + _gather[i - 1]);
+                    std::copy_n(id, ni, _gather.begin() + 2 * size + _gather[size + i]);
+                    std::iota(_gather.begin() + 2 * size + _gather[size + i] + ni, _gather.begin() + 2 * size + _gather[size + i] + ni + ki, mc + counts[5 * size + i]);
+                }
+                delete [] recv;
+                if(N) {
+                    const underlying_type<K> eps = std::sqrt(std::numeric_limits<underlying_type<K>>::epsilon());
+                    int lwork = -1, info;
+                    K wkopt;
+                    Lapack<K>::gesdd("A", &N, &N, nullptr, &N, nullptr, nullptr, &N, nullptr, &N, &wkopt, &lwork, nullptr, nullptr, &info);
+                    lwork = std::max(static_cast<int>(std::real(wkopt)), 1);
+                    K* const work = new K[3 * N * N + lwork];
+                    K* const u = work + N * N;
+                    K* const vt = u + N * N;
+                    underlying_type<K>* const sigma = new underlying_type<K>[N + (Wrapper<K>::is_complex ? N * (5 * N + 7) : 0)];
+                    int* const iwork = new int[8 * N];
+                    if(mc && kc) {
+                        for(int j = 0; j < kc; ++j)
+                            std::copy_n(saddle + (mc + j) * N, mc, work + j * mc);
+                        Lapack<K>::gesdd("A", &mc, &kc, work, &mc, sigma, u, &mc, vt, &kc, work + 3 * N * N, &lwork, sigma + N, iwork, &info);
+                        const int r = std::distance(sigma, std::find_if(sigma, sigma + std::min(mc, kc), [&](const underlying_type<K>& s) { return s <= eps * sigma[0]; }));
+                        hc = kc - r;
+                        h = new K[kc * hc];
+                        for(int j = 0; j < hc; ++j)
+                            for(int i = 0; i < kc; ++i)
+                                h[i + j * kc] = Wrapper<K>::conj(vt[r + j + i * kc]);                                          // H = null(G_I)
+                    }
+                    else if(kc) {
+                        hc = kc;
+                        h = new K[kc * hc]();
+                        for(int i = 0; i < kc; ++i)
+                            h[i * (kc + 1)] = K(1.0);
+                    }
+                    std::copy_n(saddle, N * N, work);
+                    Lapack<K>::gesdd("A", &N, &N, work, &N, sigma, u, &N, vt, &N, work + 3 * N * N, &lwork, sigma + N, iwork, &info);
+                    const int r = std::distance(sigma, std::find_if(sigma, sigma + N, [&](const underlying_type<K>& s) { return s <= eps * sigma[0]; }));
+                    for(int j = 0; j < N; ++j)
+                        for(int i = 0; i < r; ++i)
+                            vt[i + j * N] /= sigma[i];
+                    Blas<K>::gemm(&(Wrapper<K>::transc), &(Wrapper<K>::transc), &N, &N, &r, &(Wrapper<K>::d__1), vt, &N, u, &N, &(Wrapper<K>::d__0), saddle, &N);
+                    delete [] iwork;
+                    delete [] sigma;
+                    delete [] work;
+                }
+                _saddle = saddle;
+                K* const send = new K[kc * hc];
+                for(int i = 0; i < size; ++i) {
+                    for(int j = 0; j < hc; ++j)
+                        std::copy_n(h + counts[5 * size + i] + j * kc, counts[4 * size + i], send + counts[5 * size + i] * hc + j * counts[4 * size + i]);
+                    counts[4 * size + i] *= hc;
+                    counts[5 * size + i] *= hc;
+                }
+                delete [] h;
+                h = send;
+            }
+            else {
+                MPI_Gather(n, 2, MPI_INT, nullptr, 2, MPI_INT, 0, _cluster);
+                MPI_Gatherv(idx.data(), n[0], MPI_INT, nullptr, nullptr, nullptr, MPI_INT, 0, _cluster);
+                MPI_Gatherv(values, n[0] * (n[0] + k), Wrapper<K>::mpi_type(), nullptr, nullptr, nullptr, Wrapper<K>::mpi_type(), 0, _cluster);
+            }
+            delete [] values;
+            MPI_Bcast(&hc, 1, MPI_INT, 0, _cluster);
+            _sizes[1] = hc;
+            _kernel = new K[k * hc];
+            MPI_Scatterv(h, counts ? counts + 4 * size : nullptr, counts ? counts + 5 * size : nullptr, Wrapper<K>::mpi_type(), _kernel, k * hc, Wrapper<K>::mpi_type(), 0, _cluster);
+            delete [] counts;
+            delete [] h;
+            int local[2] = { 0, rank == 0 ? hc : 0 };
+            MPI_Exscan(local + 1, local, 1, MPI_INT, MPI_SUM, comm);
+            if(super::_rankWorld == 0)
+                local[0] = 0;
+            MPI_Bcast(local, 1, MPI_INT, 0, _cluster);
+            MPI_Allreduce(local + 1, _sizes + 2, 1, MPI_INT, MPI_SUM, comm);
+            local[1] = hc;
+            K* const z = new K[Subdomain<K>::_dof * hc]();
+            if(k && hc)
+                Blas<K>::gemm("N", "N", &(Subdomain<K>::_dof), &hc, &k, &(Wrapper<K>::d__1), *super::_ev + (super::_schur ? 0 : super::_bi->_m), super::_schur ? &(Subdomain<K>::_dof) : &(Subdomain<K>::_a->_n), _kernel, &k, &(Wrapper<K>::d__0), z, &(Subdomain<K>::_dof)); // Z = R H
+            std::vector<int> remote(2 * map.size());
+            for(unsigned short i = 0; i < map.size(); ++i) {
+                rq[i] = rq[map.size() + i] = MPI_REQUEST_NULL;
+                if(_first[i] == -1) {
+                    MPI_Irecv(remote.data() + 2 * i, 2, MPI_INT, map[i].first, 3, comm, rq + i);
+                    MPI_Isend(local, 2, MPI_INT, map[i].first, 3, comm, rq + map.size() + i);
+                }
+            }
+            MPI_Waitall(2 * map.size(), rq, MPI_STATUSES_IGNORE);
+            std::vector<unsigned int> displs(map.size() + 1);
+            for(unsigned short i = 0; i < map.size(); ++i)
+                displs[i + 1] = displs[i] + (_first[i] == -1 ? map[i].second.size() * remote[2 * i + 1] : 0);
+            K* const recv = new K[displs.back() + super::_mult * hc];
+            K* send = recv + displs.back();
+            for(unsigned short i = 0; i < map.size(); ++i) {
+                rq[i] = rq[map.size() + i] = MPI_REQUEST_NULL;
+                if(_first[i] == -1) {
+                    MPI_Irecv(recv + displs[i], displs[i + 1] - displs[i], Wrapper<K>::mpi_type(), map[i].first, 4, comm, rq + i);
+                    for(int c = 0; c < hc; ++c)
+                        for(unsigned int j = 0; j < map[i].second.size(); ++j)
+                            send[j + c * map[i].second.size()] = z[map[i].second[j] + c * Subdomain<K>::_dof];
+                    MPI_Isend(send, map[i].second.size() * hc, Wrapper<K>::mpi_type(), map[i].first, 4, comm, rq + map.size() + i);
+                    send += map[i].second.size() * hc;
+                }
+            }
+            _columns.resize(hc);
+            std::iota(_columns.begin(), _columns.end(), local[0]);
+            std::vector<int> position(map.size());
+            for(unsigned short i = 0; i < map.size(); ++i)
+                if(_first[i] == -1 && remote[2 * i + 1]) {
+                    std::vector<int>::const_iterator it = std::find(_columns.cbegin(), _columns.cend(), remote[2 * i]);
+                    position[i] = std::distance(_columns.cbegin(), it);
+                    if(it == _columns.cend())
+                        for(int c = 0; c < remote[2 * i + 1]; ++c)
+                            _columns.emplace_back(remote[2 * i] + c);
+                }
+            MPI_Waitall(2 * map.size(), rq, MPI_STATUSES_IGNORE);
+            const int ncol = _columns.size();
+            _ge = new K[super::_mult * ncol]();
+            for(unsigned short i = 0; i < map.size(); ++i)
+                if(_first[i] == -1) {
+                    const unsigned int row = _dual[i] - *_dual;
+                    for(unsigned int j = 0; j < map[i].second.size(); ++j) {
+                        for(int c = 0; c < hc; ++c) {
+                            const K val = z[map[i].second[j] + c * Subdomain<K>::_dof];
+                            _ge[row + j + c * super::_mult] = (i < super::_signed ? -val : val);
+                        }
+                        for(int c = 0; c < remote[2 * i + 1]; ++c) {
+                            const K val = recv[displs[i] + j + c * map[i].second.size()];
+                            _ge[row + j + (position[i] + c) * super::_mult] = (i < super::_signed ? val : -val);     // G_E = B_E Z
+                        }
+                    }
+                }
+            delete [] recv;
+            delete [] z;
+            if(_sizes[2]) {
+                K* const e = new K[ncol * ncol];
+                const K half = 0.5;
+                if(ncol)
+                    Blas<K>::gemm(&(Wrapper<K>::transc), "N", &ncol, &ncol, &(super::_mult), &half, _ge, &(super::_mult), _ge, &(super::_mult), &(Wrapper<K>::d__0), e, &ncol);
+                _coarse = new K[_sizes[2] * _sizes[2]]();
+                for(int j = 0; j < ncol; ++j)
+                    for(int i = 0; i < ncol; ++i)
+                        _coarse[_columns[i] + _columns[j] * _sizes[2]] = e[i + j * ncol];
+                delete [] e;
+                MPI_Allreduce(MPI_IN_PLACE, _coarse, _sizes[2] * _sizes[2], Wrapper<K>::mpi_type(), MPI_SUM, comm); // E = G_E^T G_E
+                int info;
+                Lapack<K>::potrf("L", _sizes + 2, _coarse, _sizes + 2, &info);
+                if(info && super::_rankWorld == 0)
+                    std::cerr << "The hybrid coarse operator is not positive definite (info = " << info << ")" << std::endl;
+            }
+        }
     public:
-        Feti() : _primal(), _dual(), _m() { }
+        Feti() : _primal(), _dual(), _m(), _cluster(MPI_COMM_NULL), _saddle(), _kernel(), _ge(), _coarse(), _sizes(), _prcndtnr(P), _adapted(false) { }
         ~Feti() {
+            if(_cluster != MPI_COMM_NULL)
+                MPI_Comm_free(&_cluster);
+            delete [] _coarse;
+            delete [] _ge;
+            delete [] _kernel;
+            delete [] _saddle;
             delete [] super::_schur;
             super::_schur = nullptr;
             if(_m)
@@ -138,68 +627,115 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          * Parameters:
          *    f              - Right-hand side.
          *    x              - Solution vector.
-         *    b              - Condensed right-hand side.
-         *    r              - First residual. */
+         *    l              - Initial Lagrange multiplier.
+         *    r              - First residual.
+         *    mu             - Number of right-hand sides. */
         template<bool excluded>
-        bool start(const K* const f, K* const x, K* const* const l, K* const* const r) const {
+        bool start(const K* const f, K* const x, K* const* const l, K* const* const r, const unsigned short& mu = 1) const {
             bool allocate = Subdomain<K>::setBuffer();
+            if(!excluded && _cluster != MPI_COMM_NULL) {
+                const int k = super::_ev ? super::getLocal() : 0;
+                const int ncol = _columns.size();
+                K* const g = new K[Subdomain<K>::_a->_n + _sizes[2] + ncol + k];
+                K* const y = g + Subdomain<K>::_a->_n;
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    const K* const fc = f + nu * Subdomain<K>::_a->_n;
+                    K* const xc = x + nu * Subdomain<K>::_a->_n;
+                    K* const* const lc = l + nu * Subdomain<K>::_map.size();
+                    K* const* const rc = r + nu * Subdomain<K>::_map.size();
+                    std::copy_n(fc, Subdomain<K>::_a->_n, xc);                                                                              //       x = f
+                    std::fill_n(*lc, super::_mult, K());
+                    if(_sizes[2]) {
+                        std::fill_n(y, _sizes[2], K());
+                        if(k && _sizes[1]) {
+                            applyKernel(fc, y + _sizes[2] + ncol);
+                            Blas<K>::gemv(&(Wrapper<K>::transc), &k, _sizes + 1, &(Wrapper<K>::d__1), _kernel, &k, y + _sizes[2] + ncol, &i__1, &(Wrapper<K>::d__0), y + _columns.front(), &i__1);
+                        }
+                        MPI_Allreduce(MPI_IN_PLACE, y, _sizes[2], Wrapper<K>::mpi_type(), MPI_SUM, Subdomain<K>::_communicator);              //       y = Z^T f
+                        int info;
+                        Lapack<K>::potrs("L", _sizes + 2, &i__1, _coarse, _sizes + 2, y, _sizes + 2, &info);                                //       y = (G_E^T G_E) \ Z^T f
+                        for(int i = 0; i < ncol; ++i)
+                            y[_sizes[2] + i] = y[_columns[i]];
+                        Blas<K>::gemv("N", &(super::_mult), &ncol, &(Wrapper<K>::d__1), _ge, &(super::_mult), y + _sizes[2], &i__1, &(Wrapper<K>::d__0), *lc, &i__1); //       l = G_E (G_E^T G_E) \ Z^T f
+                    }
+                    A<'T', 0>(_primal, lc);
+                    std::copy_n(fc, Subdomain<K>::_a->_n, g);
+                    Blas<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), _primal, &i__1, g + super::_bi->_m, &i__1);
+                    solveCluster(g);                                                                                                          //       g = K_c^+ (f - B_E^T l)
+                    A<'N', 0>(g + super::_bi->_m, rc);
+                    clearInternal(rc);                                                                                                        //       r = B_E K_c^+ (f - B_E^T l)
+                    projectHybrid(rc, nullptr);                                                                                               //       r = P^T r
+                }
+                delete [] g;
+                return allocate;
+            }
             Solver<K>* p = static_cast<Solver<K>*>(super::_pinv);
+            const int ld = excluded ? 0 : Subdomain<K>::_a->_n;
             if(super::_co) {
-                super::start();
-                if(!excluded) {
-                    if(super::_ev) {
+                super::start(mu);
+                if(!excluded && super::_ev) {
+                    for(unsigned short nu = 0; nu < mu; ++nu) {
+                        K* const uc = super::_uc + nu * *super::_co->getAddrLocal();
                         if(super::_schur) {
-                            super::condensateEffort(f, nullptr);
-                            Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_structure + super::_bi->_m, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1); //     _uc = R_b g
-                            super::_co->template callSolver<excluded>(super::_uc);                                                                                                                                                                               //     _uc = (G Q G^T) \ R_b g
-                            Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                                              // _primal = R_b (G Q G^T) \ R f
+                            super::condensateEffort(f + nu * ld, nullptr);
+                            Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_structure + super::_bi->_m, &i__1, &(Wrapper<K>::d__0), uc, &i__1); //     _uc = R_b g
                         }
-                        else {
-                            Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_a->_n), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_a->_n), f, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);                              //     _uc = R f
-                            super::_co->template callSolver<excluded>(super::_uc);                                                                                                                                                                               //     _uc = (G Q G^T) \ R f
-                            Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                           // _primal = R_b (G Q G^T) \ R f
-                        }
-                    }
-                    else {
-                        super::_co->template callSolver<excluded>(super::_uc);
-                        std::fill_n(_primal, Subdomain<K>::_dof, K());
+                        else
+                            Blas<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_a->_n), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_a->_n), f + nu * ld, &i__1, &(Wrapper<K>::d__0), uc, &i__1);          //     _uc = R f
                     }
-                    A<'N', 0>(_primal, l);                                                            //       l = A R_b (G Q G^T) \ R f
-                    precond(l);                                                                       //       l = Q A R_b (G Q G^T) \ R f
-                    A<'T', 0>(_primal, l);                                                            // _primal = A^T Q A R_b (G Q G^T) \ R f
-                    std::fill_n(super::_structure, super::_bi->_m, K());
-                    p->solve(super::_structure);                                                      // _primal = S \ A^T Q A R_b (G Q G^T) \ R f
                 }
-                else
-                    super::_co->template callSolver<excluded>(super::_uc);
+                super::_co->template callSolver<excluded>(super::_uc, mu);                                                                                                                                                                                    //     _uc = (G Q G^T) \ R f
             }
-            if(!excluded) {
-                p->solve(f, x);                                                                       //       x = S \ f
-                if(!super::_co) {
-                    A<'N', 0>(x + super::_bi->_m, r);                                                 //       r = A S \ f
-                    std::fill_n(*l, super::_mult, K());                                               //       l = 0
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                const K* const fc = f + nu * ld;
+                K* const xc = x + nu * ld;
+                K* const* const lc = l + nu * Subdomain<K>::_map.size();
+                K* const* const rc = r + nu * Subdomain<K>::_map.size();
+                if(super::_co && !excluded) {
+                    if(super::_ev) {
+                        const K* const uc = super::_uc + nu * *super::_co->getAddrLocal();
+                        if(super::_schur)
+                            Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                                              // _primal = R_b (G Q G^T) \ R f
+                        else
+                            Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                           // _primal = R_b (G Q G^T) \ R f
+                    }
+                    else
+                        std::fill_n(_primal, Subdomain<K>::_dof, K());
+                    A<'N', 0>(_primal, lc);                                                            //       l = A R_b (G Q G^T) \ R f
+                    precond<P>(lc);                                                                    //       l = Q A R_b (G Q G^T) \ R f
+                    A<'T', 0>(_primal, lc);                                                            // _primal = A^T Q A R_b (G Q G^T) \ R f
+                    std::fill_n(super::_structure, super::_bi->_m, K());
+                    p->solve(super::_structure);                                                       // _primal = S \ A^T Q A R_b (G Q G^T) \ R f
                 }
-                else {
-                    Blas<K>::axpby(Subdomain<K>::_dof, 1.0, x + super::_bi->_m, 1, -1.0, _primal, 1); // _primal = S \ (f - A^T Q A R_b (G Q G^T) \ R f)
-                    A<'N', 0>(_primal, r);                                                            //       r = A S \ (f - A^T Q A R_b (G Q G^T) \ R f)
-                    project<excluded, 'T'>(r);                                                        //       r = P^T r
+                if(!excluded) {
+                    p->solve(fc, xc);                                                                      //       x = S \ f
+                    if(!super::_co) {
+                        A<'N', 0>(xc + super::_bi->_m, rc);                                                //       r = A S \ f
+                        std::fill_n(*lc, super::_mult, K());                                               //       l = 0
+                    }
+                    else {
+                        Blas<K>::axpby(Subdomain<K>::_dof, 1.0, xc + super::_bi->_m, 1, -1.0, _primal, 1); // _primal = S \ (f - A^T Q A R_b (G Q G^T) \ R f)
+                        A<'N', 0>(_primal, rc);                                                            //       r = A S \ (f - A^T Q A R_b (G Q G^T) \ R f)
+                        project<excluded, 'T'>(rc);                                                        //       r = P^T r
+                    }
                 }
+                else if(super::_co)
+                    project<excluded, 'T'>(rc);
             }
-            else if(super::_co)
-                project<excluded, 'T'>(r);
             return allocate;
         }
         /* Function: allocateSingle
          *
-         *  Allocates a single Lagrange multiplier.
+         *  Allocates a single Lagrange multiplier, or a block of contiguous Lagrange multipliers.
          *
-         * Parameter:
-         *    mult           - Reference to a Lagrange multiplier. */
-        void allocateSingle(K**& mult) const {
-            mult  = new K*[Subdomain<K>::_map.size()];
-            *mult = new K[super::_mult];
-            for(unsigned short i = 1; i < Subdomain<K>::_map.size(); ++i)
-                mult[i] = mult[i - 1] + Subdomain<K>::_map[i - 1].second.size();
+         * Parameters:
+         *    mult           - Reference to a Lagrange multiplier.
+         *    mu             - Number of Lagrange multipliers. */
+        void allocateSingle(K**& mult, const unsigned short& mu = 1) const {
+            mult  = new K*[mu * Subdomain<K>::_map.size()];
+            *mult = new K[mu * super::_mult];
+            for(unsigned int i = 1; i < mu * Subdomain<K>::_map.size(); ++i)
+                mult[i] = mult[i - 1] + Subdomain<K>::_map[(i - 1) % Subdomain<K>::_map.size()].second.size();
         }
         /* Function: allocateArray
          *
@@ -208,17 +744,18 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          * Template Parameter:
          *    N              - Size of the array.
          *
-         * Parameter:
-         *    array          - Reference to an array of Lagrange multipliers. */
+         * Parameters:
+         *    array          - Reference to an array of Lagrange multipliers.
+         *    mu             - Number of Lagrange multipliers per entry of the array. */
         template<unsigned short N>
-        void allocateArray(K** (&array)[N]) const {
-            *array  = new K*[N * Subdomain<K>::_map.size()];
-            **array = new K[N * super::_mult];
+        void allocateArray(K** (&array)[N], const unsigned short& mu = 1) const {
+            *array  = new K*[N * mu * Subdomain<K>::_map.size()];
+            **array = new K[N * mu * super::_mult];
             for(unsigned short i = 0; i < N; ++i) {
-                array[i]  = *array + i * Subdomain<K>::_map.size();
-                *array[i] = **array + i * super::_mult;
-                for(unsigned short j = 1; j < Subdomain<K>::_map.size(); ++j)
-                    array[i][j] = array[i][j - 1] + Subdomain<K>::_map[j - 1].second.size();
+                array[i]  = *array + i * mu * Subdomain<K>::_map.size();
+                *array[i] = **array + i * mu * super::_mult;
+                for(unsigned int j = 1; j < mu * Subdomain<K>::_map.size(); ++j)
+                    array[i][j] = array[i][j - 1] + Subdomain<K>::_map[(j - 1) % Subdomain<K>::_map.size()].second.size();
             }
         }
         /* Function: buildScaling
@@ -260,13 +797,41 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *  Applies the global FETI operator.
          *
          * Parameters:
-         *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        void apply(K* const* const in, K* const* const out = nullptr) const {
-            A<'T', 0>(_primal, in);
-            std::fill_n(super::_structure, super::_bi->_m, K());
-            static_cast<Solver<K>*>(super::_pinv)->solve(super::_structure);
-            A<'N', 0>(_primal, out ? out : in);
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
+        void apply(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
+            if(_cluster != MPI_COMM_NULL) {
+                K* const g = new K[Subdomain<K>::_a->_n];
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    std::fill_n(g, super::_bi->_m, K());
+                    A<'T', 0>(g + super::_bi->_m, in + nu * Subdomain<K>::_map.size());
+                    solveCluster(g);
+                    A<'N', 0>(g + super::_bi->_m, (out ? out : in) + nu * Subdomain<K>::_map.size());
+                }
+                delete [] g;
+                clearInternal(out ? out : in, mu);
+            }
+            else if(mu == 1) {
+                A<'T', 0>(_primal, in);
+                std::fill_n(super::_structure, super::_bi->_m, K());
+                static_cast<Solver<K>*>(super::_pinv)->solve(super::_structure);
+                A<'N', 0>(_primal, out ? out : in);
+            }
+            else {
+                K* const primal = new K[mu * (Subdomain<K>::_dof + Subdomain<K>::_a->_n)];
+                K* const structure = primal + mu * Subdomain<K>::_dof;
+                A<'T', 0>(primal, in, mu);
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    std::fill_n(structure + nu * Subdomain<K>::_a->_n, super::_bi->_m, K());
+                    std::copy_n(primal + nu * Subdomain<K>::_dof, Subdomain<K>::_dof, structure + nu * Subdomain<K>::_a->_n + super::_bi->_m);
+                }
+                static_cast<Solver<K>*>(super::_pinv)->solve(structure, mu);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::copy_n(structure + nu * Subdomain<K>::_a->_n + super::_bi->_m, Subdomain<K>::_dof, primal + nu * Subdomain<K>::_dof);
+                A<'N', 0>(primal, out ? out : in, mu);
+                delete [] primal;
+            }
         }
         /* Function: applyLocalPreconditioner(n)
          *
@@ -307,16 +872,45 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         }
         /* Function: precond
          *
-         *  Applies the global preconditioner to a single right-hand side.
+         *  Applies the global preconditioner to one or multiple right-hand sides.
+         *
+         * Template Parameter:
+         *    q              - Type of <FetiPrcndtnr> to apply.
          *
          * Parameters:
-         *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        template<FetiPrcndtnr q = P>
-        void precond(K* const* const in, K* const* const out = nullptr) const {
-            A<'T', 1>(_primal, in);
-            applyLocalPreconditioner<q>(_primal);
-            A<'N', 1>(_primal, out ? out : in);
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
+        template<FetiPrcndtnr q>
+        void precond(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
+            if(mu == 1) {
+                A<'T', 1>(_primal, in);
+                applyLocalPreconditioner<q>(_primal);
+                A<'N', 1>(_primal, out ? out : in);
+            }
+            else {
+                K* primal = new K[mu * Subdomain<K>::_dof];
+                A<'T', 1>(primal, in, mu);
+                applyLocalPreconditioner<q>(primal, mu);
+                A<'N', 1>(primal, out ? out : in, mu);
+                delete [] primal;
+            }
+            if(_cluster != MPI_COMM_NULL)
+                clearInternal(out ? out : in, mu);
+        }
+        /* Function: precond
+         *
+         *  Applies <Feti::prcndtnr> to one or multiple right-hand sides. The projection always uses P, consistently with the coarse operator.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
+        void precond(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
+            if(_prcndtnr == FetiPrcndtnr::DIRICHLET)
+                precond<FetiPrcndtnr::DIRICHLET>(in, out, mu);
+            else
+                precond<P>(in, out, mu);
         }
         /* Function: project
          *
@@ -327,15 +921,62 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    trans          - 'T' if the transposed projection should be applied, 'N' otherwise.
          *
          * Parameters:
-         *    in             - Input vector.
-         *    out            - Output vector (optional). */
+         *    in             - Input vectors.
+         *    out            - Output vectors (optional).
+         *    mu             - Number of vectors. */
         template<bool excluded, char trans>
-        void project(K* const* const in, K* const* const out = nullptr) const {
+        void project(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
             static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            if(!excluded && _cluster != MPI_COMM_NULL) {
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    projectHybrid(in + nu * Subdomain<K>::_map.size(), out ? out + nu * Subdomain<K>::_map.size() : nullptr);
+                return;
+            }
+            if(mu > 1) {
+                if(super::_co) {
+                    if(!excluded) {
+                        K** dual;
+                        allocateSingle(dual, mu);
+                        if(trans == 'T')
+                            precond<P>(in, dual, mu);
+                        if(super::_ev) {
+                            K* const primal = new K[mu * Subdomain<K>::_dof];
+                            A<'T', 0>(primal, trans == 'T' ? dual : in, mu);
+                            const int tmp = mu;
+                            const int* const ld = super::_schur ? &(Subdomain<K>::_dof) : &(Subdomain<K>::_a->_n);
+                            const K* const ev = *super::_ev + (super::_schur ? 0 : super::_bi->_m);
+                            Blas<K>::gemm(&(Wrapper<K>::transc), "N", super::_co->getAddrLocal(), &tmp, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), ev, ld, primal, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, super::_co->getAddrLocal());
+                            super::_co->template callSolver<excluded>(super::_uc, mu);
+                            Blas<K>::gemm("N", "N", &(Subdomain<K>::_dof), &tmp, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), ev, ld, super::_uc, super::_co->getAddrLocal(), &(Wrapper<K>::d__0), primal, &(Subdomain<K>::_dof));
+                            A<'N', 0>(primal, dual, mu);
+                            delete [] primal;
+                        }
+                        else {
+                            super::_co->template callSolver<excluded>(super::_uc, mu);
+                            std::fill_n(*dual, mu * super::_mult, K());
+                        }
+                        if(trans == 'N')
+                            precond<P>(dual, nullptr, mu);
+                        const int n = mu * super::_mult;
+                        if(out)
+                            for(unsigned int i = 0; i < n; ++i)
+                                (*out)[i] = (*in)[i] - (*dual)[i];
+                        else
+                            Blas<K>::axpy(&n, &(Wrapper<K>::d__2), *dual, &i__1, *in, &i__1);
+                        delete [] *dual;
+                        delete [] dual;
+                    }
+                    else
+                        super::_co->template callSolver<excluded>(super::_uc, mu);
+                }
+                else if(!excluded && out)
+                    std::copy_n(*in, mu * super::_mult, *out);
+                return;
+            }
             if(super::_co) {
                 if(!excluded) {
                     if(trans == 'T')
-                        precond(in, _dual);
+                        precond<P>(in, _dual);
                     if(super::_ev) {
                         if(trans == 'T')
                             A<'T', 0>(_primal, _dual);
@@ -358,7 +999,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                     }
                     A<'N', 0>(_primal, _dual);
                     if(trans == 'N')
-                        precond(_dual);
+                        precond<P>(_dual);
                     if(out)
                         for(unsigned int i = 0; i < super::_mult; ++i)
                             (*out)[i] = (*in)[i] - (*_dual)[i];
@@ -373,7 +1014,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         }
         /* Function: buildTwo
          *
-         *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>.
+         *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>, or the coarse operators of hybrid FETI if subdomains are clustered.
          *
          * Template Parameter:
          *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
@@ -384,6 +1025,19 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          * See also: <Bdd::buildTwo>, <Schwarz::buildTwo>.*/
         template<unsigned short excluded = 0>
         std::pair<MPI_Request, const K*>* buildTwo(const MPI_Comm& comm) {
+            if(!excluded) {
+                const int cluster = Option::get()->val<int>(super::prefix("feti_cluster_size"), 0);
+                if(_cluster == MPI_COMM_NULL && cluster != 0) {
+                    if(cluster == -1)
+                        MPI_Comm_split_type(Subdomain<K>::_communicator, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &_cluster);
+                    else
+                        MPI_Comm_split(Subdomain<K>::_communicator, super::_rankWorld / std::max(cluster, 1), 0, &_cluster);
+                }
+                if(_cluster != MPI_COMM_NULL) {
+                    buildHybrid();
+                    return nullptr;
+                }
+            }
             return super::template buildTwo<excluded, FetiProjection<decltype(*this), P, K>>(this, comm);
         }
         /* Function: computeSolution
@@ -395,17 +1049,38 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    l              - Last iterate of the Lagrange multiplier.
-         *    x              - Solution vector. */
+         *    x              - Solution vector.
+         *    mu             - Number of right-hand sides. */
         template<bool excluded>
-        void computeSolution(K* const* const l, K* const x) const {
-            if(!excluded) {
+        void computeSolution(K* const* const l, K* const x, const unsigned short& mu = 1) const {
+            if(mu > 1)
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    computeSolution<excluded>(l + nu * Subdomain<K>::_map.size(), x + (excluded ? 0 : nu * Subdomain<K>::_a->_n));
+            else if(!excluded && _cluster != MPI_COMM_NULL) {
+                A<'T', 0>(_primal, l);
+                Blas<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), _primal, &i__1, x + super::_bi->_m, &i__1);                                                                                                                                    //          x = f - B_E^T l
+                solveCluster(x);                                                                                                                                                                                                                         //          x = K_c^+ (f - B_E^T l)
+                const int k = super::_ev ? super::getLocal() : 0;
+                if(_sizes[2]) {
+                    A<'N', 0>(x + super::_bi->_m, _dual);
+                    clearInternal(_dual);                                                                                                                                                                                                                //      _dual = B_E K_c^+ (f - B_E^T l)
+                    K* const y = new K[_sizes[2] + k];
+                    solveHybrid(_dual, y);
+                    if(k && _sizes[1]) {
+                        Blas<K>::gemv("N", &k, _sizes + 1, &(Wrapper<K>::d__2), _kernel, &k, y + _columns.front(), &i__1, &(Wrapper<K>::d__0), y + _sizes[2], &i__1);
+                        addKernel(y + _sizes[2], x);                                                                                                                                                                                                     //          x = x - Z (G_E^T G_E) \ G_E^T B_E x
+                    }
+                    delete [] y;
+                }
+            }
+            else if(!excluded) {
                 A<'T', 0>(_primal, l);                                                                                                                                                                                                                   //    _primal = A^T l
                 std::fill_n(super::_structure, super::_bi->_m, K());
                 static_cast<Solver<K>*>(super::_pinv)->solve(super::_structure);                                                                                                                                                                         // _structure = S \ A^T l
                 Blas<K>::axpy(&(Subdomain<K>::_a->_n), &(Wrapper<K>::d__2), super::_structure, &i__1, x, &i__1);                                                                                                                                         //          x = x - S \ A^T l
                 if(super::_co) {
                     A<'N', 0>(x + super::_bi->_m, _dual);                                                                                                                                                                                                //      _dual = A (x - S \ A^T l)
-                    precond(_dual);                                                                                                                                                                                                                      //      _dual = Q A (x - S \ A^T l)
+                    precond<P>(_dual);                                                                                                                                                                                                                   //      _dual = Q A (x - S \ A^T l)
                     if(!super::_ev)
                         super::_co->template callSolver<excluded>(super::_uc);
                     else {
@@ -416,7 +1091,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                             Blas<K>::gemv("N", &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                                      //        x_b = x_b - R_b^T (G Q G^T) \ R_b^T A^T Q A (x - S \ A^T l)
                             Wrapper<K>::template csrmv<Wrapper<K>::I>(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, _primal, &(Wrapper<K>::d__0), super::_work);
                             if(super::_bi->_m)
-                                super::_s.solve(super::_work);
+                                super::solveInterior(super::_work);
                             Blas<K>::axpy(&(super::_bi->_m), &(Wrapper<K>::d__2), super::_work, &i__1, x, &i__1);
                             Blas<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), _primal, &i__1, x + super::_bi->_m, &i__1);
                         }
@@ -432,7 +1107,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                 super::_co->template callSolver<excluded>(super::_uc);
         }
         template<bool>
-        void computeSolution(const K* const, K* const) const { }
+        void computeSolution(const K* const, K* const, const unsigned short& = 1) const { }
         /* Function: computeDot
          *
          *  Computes the dot product of two Lagrange multipliers.
@@ -441,19 +1116,88 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *
          * Parameters:
+         *    val            - Dot products, one per pair of vectors.
          *    a              - Left-hand side.
-         *    b              - Right-hand side. */
+         *    b              - Right-hand side.
+         *    comm           - Global MPI communicator.
+         *    mu             - Number of vectors. */
         template<bool excluded>
-        void computeDot(underlying_type<K>* const val, const K* const* const a, const K* const* const b, const MPI_Comm& comm) const {
+        void computeDot(underlying_type<K>* const val, const K* const* const a, const K* const* const b, const MPI_Comm& comm, const unsigned short& mu = 1) const {
             if(!excluded)
-                *val = std::real(Blas<K>::dot(&(super::_mult), *a, &i__1, *b, &i__1)) / 2.0;
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    val[nu] = std::real(Blas<K>::dot(&(super::_mult), *a + nu * super::_mult, &i__1, *b + nu * super::_mult, &i__1)) / 2.0;
             else
-                *val = 0.0;
-            MPI_Allreduce(MPI_IN_PLACE, val, 1, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+                std::fill_n(val, mu, 0.0);
+            MPI_Allreduce(MPI_IN_PLACE, val, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
         }
         /* Function: getScaling
          *  Returns a constant pointer to <Feti::m>. */
         const underlying_type<K>* const* getScaling() const { return _m; }
+        /* Function: setCluster
+         *
+         *  Sets the cluster of the local subdomain for hybrid FETI, which takes precedence over the option -hpddm_feti_cluster_size.
+         *
+         * Parameter:
+         *    comm           - Communicator of all subdomains of the cluster, ordered as in the global communicator. */
+        void setCluster(const MPI_Comm& comm) {
+            if(_cluster != MPI_COMM_NULL)
+                MPI_Comm_free(&_cluster);
+            if(comm != MPI_COMM_NULL)
+                MPI_Comm_dup(comm, &_cluster);
+        }
+        /* Function: callNumfactPreconditioner
+         *  Factorizes <Schur::ii>, unless P is not <FetiPrcndtnr::DIRICHLET> and the option -hpddm_feti_adaptive is set, in which case the factorization is done in <Feti::adapt> if needed. */
+        void callNumfactPreconditioner() {
+            if(P == FetiPrcndtnr::DIRICHLET || !Option::get()->set(super::prefix("feti_adaptive")))
+                super::callNumfactPreconditioner();
+        }
+        /* Function: adapt
+         *
+         *  Switches <Feti::prcndtnr> to <FetiPrcndtnr::DIRICHLET> during <IterativeMethod::PCG> if the estimated time to solution is lower. The condition number of the preconditioned operator is estimated using the eigenvalues of the Lanczos matrix, the one with the Dirichlet preconditioner using the asymptotic bounds kappa ~ H/h and kappa ~ (1 + log(H/h))^2, and the additional costs of the Dirichlet preconditioner using the time spent in <Schur::callNumfact>.
+         *
+         * Parameters:
+         *    lanczos        - Step lengths and conjugation coefficients of the first right-hand side.
+         *    i              - Current iteration.
+         *    elapsed        - Time spent in the iterations.
+         *    reduction      - Remaining relative reduction of the residual. */
+        bool adapt(const underlying_type<K>* const lanczos, const unsigned short& i, const double& elapsed, const underlying_type<K>& reduction) const {
+            if(P == FetiPrcndtnr::DIRICHLET || _adapted || i < Option::get()->val<unsigned short>(super::prefix("feti_adaptive"), 0) || !Option::get()->set(super::prefix("feti_adaptive")))
+                return false;
+            _adapted = true;
+            underlying_type<K>* const d = new underlying_type<K>[7 * i];
+            underlying_type<K>* const e = d + i;
+            underlying_type<K>* const w = e + i;
+            int* const iblock = new int[5 * i];
+            for(unsigned short j = 0; j < i; ++j) {
+                d[j] = 1.0 / lanczos[2 * j] + (j ? lanczos[2 * j + 1] / lanczos[2 * j - 2] : 0.0);
+                if(j < i - 1)
+                    e[j] = std::sqrt(std::abs(lanczos[2 * j + 3])) / lanczos[2 * j];
+            }
+            const int n = i;
+            const underlying_type<K> abstol = 0.0;
+            int m, nsplit, info;
+            Lapack<K>::stebz("A", "E", &n, &abstol, &abstol, &i__1, &n, &abstol, d, e, &m, &nsplit, w, iblock, iblock + i, w + i, iblock + 2 * i, &info);
+            const underlying_type<K> kappa = (info || m == 0 || w[0] <= 0.0 ? 1.0 : w[m - 1] / w[0]);
+            delete [] iblock;
+            delete [] d;
+            const underlying_type<K> ratio = (super::_schur || !super::_ii || !Subdomain<K>::_a->_ia[Subdomain<K>::_a->_n] ? 0.0 : static_cast<underlying_type<K>>(super::_ii->_nnz) / Subdomain<K>::_a->_ia[Subdomain<K>::_a->_n]);
+            double cost[2] { elapsed / i, super::_elapsed * ratio };
+            MPI_Allreduce(MPI_IN_PLACE, cost, 2, MPI_DOUBLE, MPI_MAX, Subdomain<K>::_communicator);
+            auto iterations = [&](underlying_type<K> k) { return std::ceil(std::sqrt(k) * std::log(2.0 / reduction) / 2.0); };
+            const double dirichlet = cost[1] + iterations(std::min(kappa, std::pow(1.0 + std::log(kappa), 2))) * cost[0] * (1.0 + ratio);
+            const bool swap = (kappa > 1.0 && reduction < 1.0 && dirichlet < iterations(kappa) * cost[0]);
+            if(swap) {
+                if(!super::_schur)
+                    const_cast<Feti*>(this)->super::callNumfactPreconditioner();
+                _prcndtnr = FetiPrcndtnr::DIRICHLET;
+            }
+            if(super::_rankWorld == 0 && Option::get()->val<char>(super::prefix("verbosity"), 0) > 1) {
+                std::stringstream ss;
+                ss << std::setprecision(2) << kappa;
+                std::cout << " --- Dirichlet preconditioner " << (swap ? "enabled" : "discarded") << " after " << i << " iteration" << (i > 1 ? "s" : "") << " (estimated condition number = " << ss.str() << ")" << std::endl;
+            }
+            return swap;
+        }
         /* Function: solveGEVP
          *
          *  Solves the GenEO problem.
@@ -30,6 +30,9 @@ template<class K>
 class Recycling : private Singleton {
     private:
         std::unordered_map<std::string, K*> _storage;
+        /* Variable: mutex
+         *  Mutex protecting <Recycling::storage> when multiple threads solve concurrently with different prefixes. */
+        mutable std::mutex                  _mutex;
     public:
         template<int N>
         Recycling(Singleton::construct_key<N>) { }
@@ -40,6 +43,7 @@ class Recycling : private Singleton {
         }
         template<bool reset = true>
         void destroy(const std::string& key = "") {
+            std::lock_guard<std::mutex> lock(_mutex);
             try {
                 K* pt = _storage.at(key);
                 delete [] pt;
@@ -48,7 +52,7 @@ class Recycling : private Singleton {
                     Option& opt = *Option::get();
                     unsigned short k = opt.val<unsigned short>(key + "recycle_same_system");
                     if(k > 1)
-                        opt[key + "recycle_same_system"] = 1;
+                        opt.set(key + "recycle_same_system", 1);
                 }
             }
             catch(const std::out_of_range& oor) {
@@ -56,9 +60,11 @@ class Recycling : private Singleton {
             }
         }
         bool recycling(const std::string& key = "") const {
+            std::lock_guard<std::mutex> lock(_mutex);
             return _storage.find(key) != _storage.cend();
         }
         K* allocate(int n, unsigned short mu, unsigned short k, const std::string& key = "") {
+            std::lock_guard<std::mutex> lock(_mutex);
             typename std::unordered_map<std::string, K*>::iterator it = _storage.find(key);
             if(it == _storage.end())
                 it = _storage.emplace(key, nullptr).first;
@@ -71,10 +77,12 @@ class Recycling : private Singleton {
             return it->second + 1 + ((2 * sizeof(unsigned short) - 1) / sizeof(K));
         }
         K* storage(const std::string& key = "") const {
+            std::lock_guard<std::mutex> lock(_mutex);
             typename std::unordered_map<std::string, K*>::const_iterator it = _storage.find(key);
             return it != _storage.cend() ? it->second + 1 + ((2 * sizeof(unsigned short) - 1) / sizeof(K)) : nullptr;
         }
         unsigned short k(const std::string& key = "") const {
+            std::lock_guard<std::mutex> lock(_mutex);
             try {
                 unsigned short* pt = reinterpret_cast<unsigned short*>(_storage.at(key));
                 return pt[1];
@@ -114,7 +122,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
     int k;
     unsigned short m[2];
     char id[5];
-    options<4>(A.prefix(), &tol, &k, m, id);
+    options<4>(snapshot(A), &tol, &k, m, id);
     if(k <= 0) {
         if(id[0])
             std::cout << "WARNING -- please choose a positive number of Ritz vectors to compute, now switching to GMRES" << std::endl;
@@ -477,7 +485,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
             break;
     }
     if(j != m[0] + 1 && id[4] / 4)
-        (*Option::get())[A.prefix("recycle_same_system")] += 1;
+        Option::get()->set(A.prefix("recycle_same_system"), Option::get()->val(A.prefix("recycle_same_system"), 0.0) + 1.0);
     convergence<4>(id[0], j, m[0]);
     delete [] hasConverged;
     A.end(allocate);
@@ -492,7 +500,7 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
     int k;
     unsigned short m[3];
     char id[5];
-    options<5>(A.prefix(), tol, &k, m, id);
+    options<5>(snapshot(A), tol, &k, m, id);
     if(k <= 0) {
         if(id[0])
             std::cout << "WARNING -- please choose a positive number of Ritz vectors to compute, now switching to BGMRES" << std::endl;
@@ -878,7 +886,7 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
             break;
     }
     if(j != 0 && j != m[0] + 1 && id[4] / 4)
-        (*Option::get())[A.prefix("recycle_same_system")] += 1;
+        Option::get()->set(A.prefix("recycle_same_system"), Option::get()->val(A.prefix("recycle_same_system"), 0.0) + 1.0);
     delete [] piv;
     A.end(allocate);
     delete [] *H;
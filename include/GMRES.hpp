@@ -32,7 +32,7 @@ inline int IterativeMethod::GMRES(const Operator& A, const K* const b, K* const
     underlying_type<K> tol;
     unsigned short m[2];
     char id[3];
-    options<0>(A.prefix(), &tol, nullptr, m, id);
+    options<0>(snapshot(A), &tol, nullptr, m, id);
     const int n = excluded ? 0 : A.getDof();
     K** const H = new K*[m[1] * (2 + (id[1] == 2)) + 1];
     K** const v = H + m[1];
@@ -120,7 +120,7 @@ inline int IterativeMethod::BGMRES(const Operator& A, const K* const b, K* const
     underlying_type<K> tol[2];
     unsigned short m[3];
     char id[3];
-    options<1>(A.prefix(), tol, nullptr, m, id);
+    options<1>(snapshot(A), tol, nullptr, m, id);
     const int n = excluded ? 0 : A.getDof();
     K** const H = new K*[m[1] * (2 + (id[1] == 2)) + 1];
     K** const v = H + m[1];
@@ -266,5 +266,265 @@ inline int IterativeMethod::BGMRES(const Operator& A, const K* const b, K* const
     else
         return GMRES<excluded>(A, b, x, mu, comm);
 }
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::ShiftedGMRES(const Operator& A, const K* const b, K* const x, const int& k, const K* const shifts, const MPI_Comm& comm) {
+    std::ios_base::fmtflags ff(std::cout.flags());
+    std::cout << std::scientific;
+    struct Correction {
+        const Operator& _A;
+        const bool _balanced;
+        ~Correction() {
+            if(_balanced)
+                correction(_A, -2, 0);
+        }
+    } balanced { A, snapshot(A).schwarz_coarse_correction == 2 };
+    if(balanced._balanced) {
+        if(snapshot(A).verbosity)
+            std::cout << "WARNING -- the balanced coarse correction cannot be used with shifted systems, switching to the additive coarse correction for this solve" << std::endl;
+        correction(A, 1, 0);
+    }
+    underlying_type<K> tol;
+    unsigned short m[2];
+    char id[1];
+    options<11>(snapshot(A), &tol, nullptr, m, id);
+    const int n = excluded ? 0 : A.getDof();
+    const int ldh = k + 2 * m[1];
+    int lwork = ldh;
+    K* const W = new K[(ldh + m[1] + 2) * n + (3 + k) * ldh * m[1] + ldh + k * (ldh + m[1] + k + 1) + 2 * (ldh + 2) + 2 * m[1] + 1 + lwork];
+    K* const Z = W + ldh * n;
+    K* const v = Z + m[1] * n;
+    K* const t = v + n;
+    K* const C = t + n;
+    K* const HA = C + ldh * (m[1] + 1);
+    K* const HZ = HA + ldh * m[1];
+    K* const R = HZ + ldh * m[1];
+    K* const tau = R + k * ldh * m[1];
+    K* const c = tau + k * m[1];
+    K* const G = c + k * ldh;
+    K* const res = G + k * k;
+    K* const h = res + k;
+    K* const y = h + 2 * (ldh + 2);
+    K* const hv = y + m[1];
+    K* const work = hv + m[1] + 1;
+    underlying_type<K>* const norm = new underlying_type<K>[3 * k];
+    underlying_type<K>* const workpiv = norm + k;
+    int* const piv = new int[2 * k + m[1]];
+    int* const act = piv + k;
+    int* const rows = act + k;
+    short* const hasConverged = new short[k];
+    std::fill_n(hasConverged, k, -m[1]);
+    std::fill_n(res, k, K());
+    for(int s = 0; s < k; ++s)
+        std::copy_n(b, n, W + s * n);
+    bool allocate = initializeNorm<excluded>(A, 1, W, x, t, n, t, norm, k, 1);
+    MPI_Allreduce(MPI_IN_PLACE, norm, k, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    for(int s = 0; s < k; ++s) {
+        norm[s] = std::sqrt(norm[s]);
+        if(norm[s] < HPDDM_EPS)
+            norm[s] = 1.0;
+    }
+    const underlying_type<K> drop = 1.0e+2 * std::numeric_limits<underlying_type<K>>::epsilon();
+    unsigned short j = 0;
+    bool converged = false;
+    int info;
+    while(true) {
+        int ka = 0;
+        for(int s = 0; s < k; ++s)
+            if(hasConverged[s] == -m[1])
+                act[ka++] = s;
+        for(int l = 0; l < ka; ++l) {
+            K* const r = W + l * n;
+            if(!excluded) {
+                A.GMV(x + act[l] * n, r, 1);
+                mass(A, x + act[l] * n, t, 1, 0);
+            }
+            Blas<K>::axpby(n, shifts[act[l]], t, 1, -1.0, r, 1);
+            Blas<K>::axpy(&n, &(Wrapper<K>::d__1), b, &i__1, r, &i__1);
+        }
+        VR<excluded>(n, ka, 1, W, G, ka, comm);
+        for(int l = 0; l < ka; ++l)
+            res[act[l]] = std::sqrt(std::real(G[l * (ka + 1)]));
+        checkConvergence<11>(id[0], j, 0, tol, k, norm, res, hasConverged, m[1]);
+        int kb = 0;
+        for(int l = 0; l < ka; ++l)
+            if(hasConverged[act[l]] == -m[1]) {
+                if(kb != l && !excluded && n)
+                    std::copy_n(W + l * n, n, W + kb * n);
+                piv[kb] = l;
+                for(int q = 0; q <= kb; ++q)
+                    G[q + kb * ka] = G[piv[q] + l * ka];
+                act[kb++] = act[l];
+            }
+        if(kb == 0) {
+            converged = true;
+            break;
+        }
+        if(j >= m[0])
+            break;
+        int N;
+        Lapack<K>::pstrf("U", &kb, G, &ka, piv, &N, &(Wrapper<underlying_type<K>>::d__0), workpiv, &info);
+        if(info == 0)
+            N = kb;
+        if(!excluded && n) {
+            Lapack<K>::lapmt(&i__1, &n, &kb, W, &n, piv);
+            Blas<K>::trsm("R", "U", "N", "N", &n, &N, &(Wrapper<K>::d__1), G, &ka, W, &n);
+        }
+        std::fill_n(c, k * ldh, K());
+        for(int l = 0; l < kb; ++l)
+            std::copy_n(G + l * ka, std::min(l + 1, N), c + act[piv[l] - 1] * ldh);
+        auto worst = [&]() {
+            int w = -1;
+            for(int l = 0; l < kb; ++l)
+                if(hasConverged[act[l]] == -m[1] && (w == -1 || std::abs(res[act[l]]) > std::abs(res[w])))
+                    w = act[l];
+            return w;
+        };
+        int seed = worst();
+        int first = 0;
+        std::fill_n(C, (3 + k) * ldh * m[1] + ldh, K());
+        std::copy_n(c + seed * ldh, N, C);
+        {
+            const K alpha = K(1.0 / Blas<K>::nrm2(&N, C, &i__1));
+            Blas<K>::scal(&N, &alpha, C, &i__1);
+        }
+        if(!excluded && n)
+            Blas<K>::gemv("N", &n, &N, &(Wrapper<K>::d__1), W, &n, C, &i__1, &(Wrapper<K>::d__0), v, &i__1);
+        int p = N;
+        unsigned short i = 0;
+        while(i < m[1] && j < m[0]) {
+            K* const a = W + p * n;
+            K* const u = a + n;
+            A.template apply<excluded>(v, Z + i * n, 1, t);
+            if(!excluded) {
+                A.GMV(Z + i * n, a, 1);
+                mass(A, Z + i * n, u, 1, 0);
+            }
+            const int two = 2;
+            int q = p + 2;
+            underlying_type<K> nrm[2];
+            for(unsigned short pass = 0; pass < 2; ++pass) {
+                if(!excluded && n)
+                    Blas<K>::gemm(&(Wrapper<K>::transc), "N", &q, &two, &n, &(Wrapper<K>::d__1), W, &n, a, &n, &(Wrapper<K>::d__0), h, &q);
+                else
+                    std::fill_n(h, 2 * q, K());
+                MPI_Allreduce(MPI_IN_PLACE, h, 2 * q, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                if(pass == 0) {
+                    nrm[0] = std::sqrt(std::real(h[p]));
+                    nrm[1] = std::sqrt(std::real(h[q + p + 1]));
+                }
+                if(!excluded) {
+                    if(n)
+                        Blas<K>::gemm("N", "N", &n, &two, &p, &(Wrapper<K>::d__2), W, &n, h, &q, &(Wrapper<K>::d__1), a, &n);
+                    consistent(A, a, 2, 0);
+                }
+                Blas<K>::axpy(&p, &(Wrapper<K>::d__1), h, &i__1, HA + i * ldh, &i__1);
+                Blas<K>::axpy(&p, &(Wrapper<K>::d__1), h + q, &i__1, HZ + i * ldh, &i__1);
+            }
+            const underlying_type<K> g00 = std::real(h[p] - Blas<K>::dot(&p, h, &i__1, h, &i__1));
+            K g01 = h[q + p] - Blas<K>::dot(&p, h, &i__1, h + q, &i__1);
+            underlying_type<K> g11 = std::real(h[q + p + 1] - Blas<K>::dot(&p, h + q, &i__1, h + q, &i__1));
+            const int prev = p;
+            const underlying_type<K> r11 = std::sqrt(std::max(g00, underlying_type<K>()));
+            if(r11 > drop * nrm[0]) {
+                K alpha = K(1.0 / r11);
+                Blas<K>::scal(&n, &alpha, a, &i__1);
+                HA[p + i * ldh] = r11;
+                alpha = g01 / r11;
+                HZ[p + i * ldh] = alpha;
+                g11 -= std::norm(alpha);
+                alpha = -alpha;
+                Blas<K>::axpy(&n, &alpha, a, &i__1, u, &i__1);
+                ++p;
+            }
+            const underlying_type<K> r22 = std::sqrt(std::max(g11, underlying_type<K>()));
+            if(r22 > drop * nrm[1]) {
+                const K alpha = K(1.0 / r22);
+                Blas<K>::scal(&n, &alpha, u, &i__1);
+                if(p == prev)
+                    std::copy_n(u, n, a);
+                HZ[p++ + i * ldh] = r22;
+            }
+            rows[i] = p;
+            for(int l = 0; l < kb; ++l) {
+                const int s = act[l];
+                if(hasConverged[s] != -m[1])
+                    continue;
+                K* const Rs = R + s * ldh * m[1];
+                K* const rs = Rs + i * ldh;
+                for(int row = 0; row < p; ++row)
+                    rs[row] = HA[row + i * ldh] - shifts[s] * HZ[row + i * ldh];
+                int dim = i;
+                if(dim)
+                    Lapack<K>::mqr("L", &(Wrapper<K>::transc), &p, &i__1, &dim, Rs, &ldh, tau + s * m[1], rs, &ldh, work, &lwork, &info);
+                dim = p - i;
+                Lapack<K>::geqrf(&dim, &i__1, rs + i, &ldh, tau + s * m[1] + i, work, &lwork, &info);
+                Lapack<K>::mqr("L", &(Wrapper<K>::transc), &dim, &i__1, &i__1, rs + i, &ldh, tau + s * m[1] + i, c + s * ldh + i, &ldh, work, &lwork, &info);
+                --dim;
+                res[s] = Blas<K>::nrm2(&dim, c + s * ldh + i + 1, &i__1);
+            }
+            ++i;
+            ++j;
+            checkConvergence<11>(id[0], j, i, tol, k, norm, res, hasConverged, m[1]);
+            if(std::none_of(act, act + kb, [&](const int s) { return hasConverged[s] == -m[1]; }))
+                break;
+            const int col = i;
+            if(hasConverged[seed] != -m[1]) {
+                seed = worst();
+                first = col;
+                std::fill_n(C + col * ldh, i, K());
+                std::copy(c + seed * ldh + i, c + seed * ldh + p, C + col * ldh + i);
+                Lapack<K>::mqr("L", "N", &p, &i__1, &col, R + seed * ldh * m[1], &ldh, tau + seed * m[1], C + col * ldh, &ldh, work, &lwork, &info);
+            }
+            else
+                for(int row = 0; row < p; ++row)
+                    C[row + col * ldh] = HA[row + (i - 1) * ldh] - shifts[seed] * HZ[row + (i - 1) * ldh];
+            const underlying_type<K> eta = Blas<K>::nrm2(&p, C + col * ldh, &i__1);
+            const int dim = col - first;
+            if(dim)
+                for(unsigned short pass = 0; pass < 2; ++pass) {
+                    Blas<K>::gemv(&(Wrapper<K>::transc), &p, &dim, &(Wrapper<K>::d__1), C + first * ldh, &ldh, C + col * ldh, &i__1, &(Wrapper<K>::d__0), hv, &i__1);
+                    Blas<K>::gemv("N", &p, &dim, &(Wrapper<K>::d__2), C + first * ldh, &ldh, hv, &i__1, &(Wrapper<K>::d__1), C + col * ldh, &i__1);
+                }
+            const underlying_type<K> beta = Blas<K>::nrm2(&p, C + col * ldh, &i__1);
+            if(!(beta > drop * eta)) {
+                if(id[0] > 1)
+                    std::cout << "WARNING -- ShiftedGMRES breakdown after " << j << " iteration" << (j > 1 ? "s" : "") << ", restarting" << std::endl;
+                break;
+            }
+            const K alpha = K(1.0 / beta);
+            Blas<K>::scal(&p, &alpha, C + col * ldh, &i__1);
+            if(!excluded && n)
+                Blas<K>::gemv("N", &n, &p, &(Wrapper<K>::d__1), W, &n, C + col * ldh, &i__1, &(Wrapper<K>::d__0), v, &i__1);
+        }
+        for(int l = 0; l < kb; ++l) {
+            const int s = act[l];
+            int dim = hasConverged[s] == -m[1] ? i : hasConverged[s];
+            if(dim > 0) {
+                std::copy_n(c + s * ldh, dim, y);
+                Blas<K>::trsv("U", "N", "N", &dim, R + s * ldh * m[1], &ldh, y, &i__1);
+                if(!excluded && n)
+                    Blas<K>::gemv("N", &n, &dim, &(Wrapper<K>::d__1), Z, &n, y, &i__1, &(Wrapper<K>::d__1), x + s * n, &i__1);
+            }
+            if(hasConverged[s] != -m[1])
+                hasConverged[s] = 0;
+        }
+        if(std::find(hasConverged, hasConverged + k, -m[1]) == hasConverged + k) {
+            converged = true;
+            break;
+        }
+        if(j >= m[0])
+            break;
+        if(id[0] > 1)
+            std::cout << "ShiftedGMRES restart(" << m[1] << ")" << std::endl;
+    }
+    convergence<11>(id[0], converged ? j : m[0] + 1, m[0]);
+    delete [] hasConverged;
+    delete [] piv;
+    delete [] norm;
+    delete [] W;
+    A.end(allocate);
+    std::cout.flags(ff);
+    return std::min(j, m[0]);
+}
 } // HPDDM
 #endif // _HPDDM_GMRES_
@@ -34,6 +34,7 @@
  *    HPDDM_EPS           - Small positive number used internally for dropping values.
  *    HPDDM_PEN           - Large positive number used externally for penalization, e.g. for imposing Dirichlet boundary conditions.
  *    HPDDM_GRANULARITY   - Granularity for OpenMP scheduling.
+ *    HPDDM_BLR_TILE      - Size of the tiles of local Schur complements stored in block low-rank format.
  *    HPDDM_MPI           - If not set to zero, MPI is supposed to be activated during compilation and for running the library.
  *    HPDDM_MKL           - If not set to zero, Intel MKL is chosen as the linear algebra backend.
  *    HPDDM_NUMBERING     - 0- or 1-based indexing of user-supplied matrices.
@@ -48,6 +49,7 @@
 #define HPDDM_EPS             1.0e-12
 #define HPDDM_PEN             1.0e+30
 #define HPDDM_GRANULARITY     50000
+#define HPDDM_BLR_TILE        128
 #ifndef HPDDM_NUMBERING
 # pragma message("The numbering of user-supplied matrices has not been set, assuming 0-based indexing")
 # define HPDDM_NUMBERING      'C'
@@ -160,7 +162,11 @@ static_assert(HPDDM_NUMBERING == 'C' || HPDDM_NUMBERING == 'F', "Unknown numberi
 # include <algorithm>
 # include <vector>
 # include <numeric>
+# include <random>
 # include <functional>
+# include <mutex>
+# include <atomic>
+# include <array>
 # if !__cpp_rtti && !defined(__GXX_RTTI) && !defined(__INTEL_RTTI__) && !defined(_CPPRTTI)
 #  pragma message("Consider enabling RTTI support with your C++ compiler")
 # endif
@@ -362,6 +368,9 @@ typedef int MPI_Comm;
 #  include "GMRES.hpp"
 #  include "GCRODR.hpp"
 #  include "CG.hpp"
+#  include "BiCGStab.hpp"
+#  include "IDR.hpp"
+#  include "MINRES.hpp"
 #  if !HPDDM_MPI
 #   undef MPI_Allreduce
 #  endif
@@ -0,0 +1,216 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): agent <agent@local>
+        Date: 2026-10-18
+
+   Copyright (C) 2016-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_IDR_
+#define _HPDDM_IDR_
+
+#include "iterative.hpp"
+
+namespace HPDDM {
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::IDR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short m[2];
+    char id[2];
+    options<8>(snapshot(A), &tol, nullptr, m, id);
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = mu * n;
+    const int s = m[1];
+    K* const P = new K[s * n + (2 * s + 5) * dim + mu * (s * s + 3 * s + 5)];
+    K* const G = P + s * n;
+    K* const U = G + s * dim;
+    K* const r = U + s * dim;
+    K* const v = r + dim;
+    K* const t = v + dim;
+    K* const z = t + dim;
+    K* const w = z + dim;
+    K* const M = w + dim;
+    K* const f = M + mu * s * s;
+    K* const c = f + mu * (s + 1);
+    K* const dots = c + mu * s;
+    K* const omega = dots + mu * (s + 3);
+    underlying_type<K>* const norm = new underlying_type<K>[mu];
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -m[0]);
+    auto precond = [&](const K* const in, K* const out) {
+        if(id[1] == 0)
+            std::copy_n(in, dim, out);
+        else
+            A.template apply<excluded>(in, out, mu, w);
+    };
+    auto op = [&](const K* const in, K* const out) {
+        if(id[1] == 0) {
+            if(!excluded)
+                A.GMV(in, z, mu);
+            A.template apply<excluded>(z, out, mu);
+        }
+        else if(!excluded)
+            A.GMV(in, out, mu);
+    };
+    bool allocate = initializeNorm<excluded>(A, id[1], b, x, r, n, z, norm, mu, 1);
+    if(!excluded)
+        A.GMV(x, z, mu);
+    Blas<K>::axpby(dim, 1.0, b, 1, -1.0, z, 1);
+    if(id[1] == 0)
+        A.template apply<excluded>(z, r, mu);
+    else
+        std::copy_n(z, dim, r);
+    MPI_Allreduce(MPI_IN_PLACE, norm, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    for(unsigned short nu = 0; nu < mu; ++nu) {
+        norm[nu] = std::sqrt(norm[nu]);
+        if(norm[nu] < HPDDM_EPS)
+            norm[nu] = 1.0;
+    }
+    {
+        int rank;
+        MPI_Comm_rank(comm, &rank);
+        std::mt19937 gen(rank);
+        std::uniform_real_distribution<underlying_type<K>> dis(-1.0, 1.0);
+        std::generate_n(P, s * n, [&]() { return K(dis(gen)); });
+        if(QR<excluded>(0, n, s, 1, P, M, s, comm) && id[0])
+            std::cout << "WARNING -- the shadow space of IDR could not be orthonormalized" << std::endl;
+    }
+    std::fill_n(G, 2 * s * dim, K());
+    for(unsigned short nu = 0; nu < mu; ++nu) {
+        std::fill_n(M + nu * s * s, s * s, K());
+        for(unsigned short k = 0; k < s; ++k)
+            M[nu * s * s + k * (s + 1)] = K(1.0);
+    }
+    std::fill_n(omega, mu, K(1.0));
+    auto breakdown = [&](const unsigned short nu, const unsigned short i) {
+        if(id[0])
+            std::cout << "WARNING -- IDR breakdown for rhs #" << nu + 1 << " after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+        hasConverged[nu] = i;
+    };
+    unsigned short i = 0;
+    bool converged = false;
+    while(i < m[0]) {
+        if(!excluded && n)
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &s, &mu, &n, &(Wrapper<K>::d__1), P, &n, r, &n, &(Wrapper<K>::d__0), f, &s);
+        else
+            std::fill_n(f, mu * s, K());
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            dots[nu] = Blas<K>::dot(&n, r + nu * n, &i__1, r + nu * n, &i__1);
+        std::copy_n(dots, mu, f + mu * s);
+        MPI_Allreduce(MPI_IN_PLACE, f, mu * (s + 1), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            dots[nu] = std::sqrt(std::real(f[mu * s + nu]));
+        checkConvergence<8>(id[0], i, i, tol, mu, norm, dots, hasConverged, m[0]);
+        if(std::find(hasConverged, hasConverged + mu, -m[0]) == hasConverged + mu) {
+            converged = true;
+            break;
+        }
+        for(unsigned short k = 0; k < s && i < m[0]; ++k) {
+            const int sk = s - k;
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                std::copy_n(f + nu * s + k, sk, c + nu * s);
+                Blas<K>::trsv("L", "N", "N", &sk, M + nu * s * s + k * (s + 1), &s, c + nu * s, &i__1);
+                std::copy_n(r + nu * n, n, v + nu * n);
+                if(!excluded && n)
+                    Blas<K>::gemv("N", &n, &sk, &(Wrapper<K>::d__2), G + k * dim + nu * n, &dim, c + nu * s, &i__1, &(Wrapper<K>::d__1), v + nu * n, &i__1);
+            }
+            precond(v, t);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                Blas<K>::scal(&n, omega + nu, t + nu * n, &i__1);
+                if(!excluded && n)
+                    Blas<K>::gemv("N", &n, &sk, &(Wrapper<K>::d__1), U + k * dim + nu * n, &dim, c + nu * s, &i__1, &(Wrapper<K>::d__1), t + nu * n, &i__1);
+            }
+            std::copy_n(t, dim, U + k * dim);
+            op(U + k * dim, G + k * dim);
+            ++i;
+            if(!excluded && n)
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    Blas<K>::gemv(&(Wrapper<K>::transc), &n, &s, &(Wrapper<K>::d__1), P, &n, G + k * dim + nu * n, &i__1, &(Wrapper<K>::d__0), dots + nu * s, &i__1);
+            else
+                std::fill_n(dots, mu * s, K());
+            MPI_Allreduce(MPI_IN_PLACE, dots, mu * s, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                K* const Mnu = M + nu * s * s;
+                K* const h = dots + nu * s;
+                if(k > 0) {
+                    int dk = k;
+                    std::copy_n(h, dk, c + nu * s);
+                    Blas<K>::trsv("L", "N", "N", &dk, Mnu, &s, c + nu * s, &i__1);
+                    Blas<K>::gemv("N", &sk, &dk, &(Wrapper<K>::d__2), Mnu + k, &s, c + nu * s, &i__1, &(Wrapper<K>::d__1), h + k, &i__1);
+                    if(!excluded && n) {
+                        Blas<K>::gemv("N", &n, &dk, &(Wrapper<K>::d__2), G + nu * n, &dim, c + nu * s, &i__1, &(Wrapper<K>::d__1), G + k * dim + nu * n, &i__1);
+                        Blas<K>::gemv("N", &n, &dk, &(Wrapper<K>::d__2), U + nu * n, &dim, c + nu * s, &i__1, &(Wrapper<K>::d__1), U + k * dim + nu * n, &i__1);
+                    }
+                }
+                std::copy_n(h + k, sk, Mnu + k * (s + 1));
+                K beta = K();
+                if(hasConverged[nu] == -m[0]) {
+                    if(std::abs(Mnu[k * (s + 1)]) < std::numeric_limits<underlying_type<K>>::min())
+                        breakdown(nu, i);
+                    else
+                        beta = f[nu * s + k] / Mnu[k * (s + 1)];
+                }
+                Blas<K>::axpy(&n, &beta, U + k * dim + nu * n, &i__1, x + nu * n, &i__1);
+                beta = -beta;
+                Blas<K>::axpy(&n, &beta, G + k * dim + nu * n, &i__1, r + nu * n, &i__1);
+                if(k + 1 < s) {
+                    const int sk1 = sk - 1;
+                    Blas<K>::axpy(&sk1, &beta, Mnu + k * (s + 1) + 1, &i__1, f + nu * s + k + 1, &i__1);
+                }
+            }
+        }
+        if(i >= m[0])
+            break;
+        precond(r, v);
+        op(v, t);
+        ++i;
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            dots[3 * nu] = Blas<K>::dot(&n, t + nu * n, &i__1, r + nu * n, &i__1);
+            dots[3 * nu + 1] = Blas<K>::dot(&n, t + nu * n, &i__1, t + nu * n, &i__1);
+            dots[3 * nu + 2] = Blas<K>::dot(&n, r + nu * n, &i__1, r + nu * n, &i__1);
+        }
+        MPI_Allreduce(MPI_IN_PLACE, dots, 3 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            omega[nu] = K();
+            if(hasConverged[nu] == -m[0]) {
+                if(std::abs(dots[3 * nu + 1]) < std::numeric_limits<underlying_type<K>>::min())
+                    breakdown(nu, i);
+                else {
+                    omega[nu] = dots[3 * nu] / dots[3 * nu + 1];
+                    const underlying_type<K> rho = std::abs(dots[3 * nu]) / std::sqrt(std::real(dots[3 * nu + 1]) * std::real(dots[3 * nu + 2]));
+                    if(rho < 0.7)
+                        omega[nu] *= 0.7 / rho;
+                    if(std::abs(omega[nu]) < std::numeric_limits<underlying_type<K>>::min())
+                        breakdown(nu, i);
+                }
+            }
+            Blas<K>::axpy(&n, omega + nu, v + nu * n, &i__1, x + nu * n, &i__1);
+            K alpha = -omega[nu];
+            Blas<K>::axpy(&n, &alpha, t + nu * n, &i__1, r + nu * n, &i__1);
+            if(hasConverged[nu] != -m[0])
+                omega[nu] = K(1.0);
+        }
+    }
+    convergence<8>(id[0], converged ? i : m[0] + 1, m[0]);
+    delete [] hasConverged;
+    delete [] norm;
+    delete [] P;
+    A.end(allocate);
+    return std::min(i, m[0]);
+}
+} // HPDDM
+#endif // _HPDDM_IDR_
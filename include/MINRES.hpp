@@ -0,0 +1,340 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): agent <agent@local>
+        Date: 2026-10-18
+
+   Copyright (C) 2016-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_MINRES_
+#define _HPDDM_MINRES_
+
+#include "iterative.hpp"
+
+namespace HPDDM {
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::MINRES(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short it;
+    char id[2];
+    {
+        const OptionsSnapshot& opt = snapshot(A);
+        if(opt.schwarz_method == 0 || opt.schwarz_method == 1 || opt.schwarz_method == 4 || opt.schwarz_method == 6 || opt.schwarz_coarse_correction == 0)
+            return GMRES<excluded>(A, b, x, mu, comm);
+        options<9>(opt, &tol, nullptr, &it, id);
+    }
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = n * mu;
+    K* const work = new K[9 * dim + mu];
+    K* r1 = work;
+    K* r2 = r1 + dim;
+    K* const y = r2 + dim;
+    K* const z = y + dim;
+    K* const v = z + dim;
+    K* w = v + dim;
+    K* w1 = w + dim;
+    K* w2 = w1 + dim;
+    K* const trash = w2 + dim;
+    K* const res = trash + dim;
+    underlying_type<K>* const dots = new underlying_type<K>[12 * mu];
+    underlying_type<K>* const norm = dots + 3 * mu;
+    underlying_type<K>* const beta = norm + mu;
+    underlying_type<K>* const oldb = beta + mu;
+    underlying_type<K>* const alpha = oldb + mu;
+    underlying_type<K>* const cs = alpha + mu;
+    underlying_type<K>* const sn = cs + mu;
+    underlying_type<K>* const dbar = sn + mu;
+    underlying_type<K>* const epsln = dbar + mu;
+    underlying_type<K>* const phibar = epsln + mu;
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -it);
+    const underlying_type<K>* const d = A.getScaling();
+    bool allocate = A.template start<excluded>(b, x, mu);
+    if(!excluded)
+        A.GMV(x, z, mu);
+    std::copy_n(b, dim, r2);
+    Blas<K>::axpy(&dim, &(Wrapper<K>::d__2), z, &i__1, r2, &i__1);
+    const bool guess = snapshot(A).initial_guess;
+    if(guess)
+        referenceNorm<excluded>(A, b, n, true, norm, mu, 1, comm);
+    std::fill_n(r1, dim, K());
+    std::fill_n(w, 2 * dim, K());
+    std::fill_n(oldb, mu, 1.0);
+    std::fill_n(cs, mu, -1.0);
+    std::fill_n(sn, mu, 0.0);
+    std::fill_n(dbar, 2 * mu, 0.0);
+    auto breakdown = [&](const unsigned short nu, const unsigned short i, const char* const reason) {
+        if(id[0])
+            std::cout << "WARNING -- MINRES breakdown for rhs #" << nu + 1 << " after " << i << " iteration" << (i > 1 ? "s" : "") << reason << std::endl;
+        hasConverged[nu] = i;
+    };
+    unsigned short i = 0;
+    bool converged = false;
+    while(true) {
+        A.template apply<excluded>(r2, y, mu, trash);
+        if(!excluded)
+            A.GMV(y, z, mu);
+        Wrapper<K>::diag(n, d, y, trash, mu);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            dots[3 * nu] = std::real(Blas<K>::dot(&n, trash + n * nu, &i__1, r2 + n * nu, &i__1));
+            dots[3 * nu + 1] = std::real(Blas<K>::dot(&n, trash + n * nu, &i__1, z + n * nu, &i__1));
+            dots[3 * nu + 2] = std::real(Blas<K>::dot(&n, trash + n * nu, &i__1, r1 + n * nu, &i__1));
+        }
+        MPI_Allreduce(MPI_IN_PLACE, dots, 3 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            if(dots[3 * nu] < 0.0) {
+                if(hasConverged[nu] == -it)
+                    breakdown(nu, i, ", the preconditioner is not positive definite");
+                dots[3 * nu] = 0.0;
+            }
+            beta[nu] = std::sqrt(dots[3 * nu]);
+            if(i == 0) {
+                phibar[nu] = beta[nu];
+                if(!guess) {
+                    norm[nu] = beta[nu];
+                    if(norm[nu] < HPDDM_EPS)
+                        norm[nu] = 1.0;
+                }
+            }
+            else if(hasConverged[nu] == -it) {
+                const underlying_type<K> oldeps = epsln[nu];
+                const underlying_type<K> delta = cs[nu] * dbar[nu] + sn[nu] * alpha[nu];
+                const underlying_type<K> gbar = sn[nu] * dbar[nu] - cs[nu] * alpha[nu];
+                epsln[nu] = sn[nu] * beta[nu];
+                dbar[nu] = -cs[nu] * beta[nu];
+                const underlying_type<K> gamma = std::sqrt(gbar * gbar + beta[nu] * beta[nu]);
+                if(gamma < std::numeric_limits<underlying_type<K>>::min()) {
+                    breakdown(nu, i, "");
+                    continue;
+                }
+                cs[nu] = gbar / gamma;
+                sn[nu] = beta[nu] / gamma;
+                const K phi = cs[nu] * phibar[nu];
+                phibar[nu] *= sn[nu];
+                std::copy_n(v + n * nu, n, w1 + n * nu);
+                Blas<K>::axpby(n, -delta, w + n * nu, 1, 1.0, w1 + n * nu, 1);
+                Blas<K>::axpby(n, -oldeps, w2 + n * nu, 1, 1.0, w1 + n * nu, 1);
+                const K scal = 1.0 / gamma;
+                Blas<K>::scal(&n, &scal, w1 + n * nu, &i__1);
+                Blas<K>::axpy(&n, &phi, w1 + n * nu, &i__1, x + n * nu, &i__1);
+            }
+            res[nu] = phibar[nu];
+        }
+        if(i) {
+            std::swap(w2, w1);
+            std::swap(w, w2);
+        }
+        checkConvergence<9>(id[0], i, i, tol, mu, norm, res, hasConverged, it);
+        if(std::find(hasConverged, hasConverged + mu, -it) == hasConverged + mu) {
+            converged = true;
+            break;
+        }
+        if(i == it)
+            break;
+        ++i;
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            if(hasConverged[nu] == -it) {
+                alpha[nu] = dots[3 * nu + 1] / (beta[nu] * beta[nu]) - dots[3 * nu + 2] / oldb[nu];
+                Blas<K>::axpby(n, 1.0 / beta[nu], y + n * nu, 1, 0.0, v + n * nu, 1);
+                Blas<K>::axpby(n, 1.0 / beta[nu], z + n * nu, 1, -beta[nu] / oldb[nu], r1 + n * nu, 1);
+                Blas<K>::axpby(n, -alpha[nu] / beta[nu], r2 + n * nu, 1, 1.0, r1 + n * nu, 1);
+                oldb[nu] = beta[nu];
+            }
+        }
+        std::swap(r1, r2);
+    }
+    convergence<9>(id[0], converged ? i : it + 1, it);
+    delete [] hasConverged;
+    delete [] dots;
+    delete [] work;
+    A.end(allocate);
+    return std::min(i, it);
+}
+
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::BMINRES(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short it;
+    char id[2];
+    {
+        const OptionsSnapshot& opt = snapshot(A);
+        if(opt.schwarz_method == 0 || opt.schwarz_method == 1 || opt.schwarz_method == 4 || opt.schwarz_method == 6 || opt.schwarz_coarse_correction == 0)
+            return GMRES<excluded>(A, b, x, mu, comm);
+        if(mu == 1)
+            return MINRES<excluded>(A, b, x, mu, comm);
+        options<10>(opt, &tol, nullptr, &it, id);
+    }
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = n * mu;
+    const int ldc = 4 * mu;
+    const int ldh = 2 * mu;
+    const int lwork = mu * mu;
+    K* const work = new K[9 * dim + 24 * mu * mu + 3 * mu];
+    K* r1 = work;
+    K* r2 = r1 + dim;
+    K* const y = r2 + dim;
+    K* const z = y + dim;
+    K* const v = z + dim;
+    K* p = v + dim;
+    K* p1 = p + dim;
+    K* p2 = p1 + dim;
+    K* const trash = p2 + dim;
+    K* const G = trash + dim;
+    K* const beta = G + 3 * mu * mu;
+    K* const oldb = beta + mu * mu;
+    K* const alpha = oldb + mu * mu;
+    K* const C = alpha + mu * mu;
+    K* const col = C + mu * mu;
+    K* const rhs = col + ldc * mu;
+    K* H[2] = { rhs + ldh * mu, rhs + 2 * ldh * mu };
+    K* const qwork = H[1] + ldh * mu;
+    K* tau[2] = { qwork + lwork, qwork + lwork + mu };
+    K* const res = tau[1] + mu;
+    underlying_type<K>* const norm = new underlying_type<K>[mu];
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -it);
+    const underlying_type<K>* const d = A.getScaling();
+    bool allocate = A.template start<excluded>(b, x, mu);
+    if(!excluded)
+        A.GMV(x, z, mu);
+    std::copy_n(b, dim, r2);
+    Blas<K>::axpy(&dim, &(Wrapper<K>::d__2), z, &i__1, r2, &i__1);
+    const bool guess = snapshot(A).initial_guess;
+    if(guess)
+        referenceNorm<excluded>(A, b, n, true, norm, mu, 1, comm);
+    std::fill_n(r1, dim, K());
+    std::fill_n(p, 3 * dim, K());
+    std::fill_n(oldb, mu * mu, K());
+    for(unsigned short nu = 0; nu < mu; ++nu)
+        oldb[nu * (mu + 1)] = K(1.0);
+    std::fill_n(rhs, ldh * mu, K());
+    auto fallback = [&]() {
+        delete [] hasConverged;
+        delete [] norm;
+        delete [] work;
+        A.end(allocate);
+        return MINRES<excluded>(A, b, x, mu, comm);
+    };
+    unsigned short i = 0;
+    bool converged = false;
+    int info;
+    while(true) {
+        A.template apply<excluded>(r2, y, mu, trash);
+        if(!excluded)
+            A.GMV(y, z, mu);
+        Wrapper<K>::diag(n, d, y, trash, mu);
+        if(!excluded && n) {
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &mu, &mu, &n, &(Wrapper<K>::d__1), trash, &n, r2, &n, &(Wrapper<K>::d__0), G, &mu);
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &mu, &mu, &n, &(Wrapper<K>::d__1), trash, &n, z, &n, &(Wrapper<K>::d__0), G + mu * mu, &mu);
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &mu, &mu, &n, &(Wrapper<K>::d__1), trash, &n, r1, &n, &(Wrapper<K>::d__0), G + 2 * mu * mu, &mu);
+        }
+        else
+            std::fill_n(G, 3 * mu * mu, K());
+        MPI_Allreduce(MPI_IN_PLACE, G, 3 * mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        std::copy_n(G, mu * mu, beta);
+        Lapack<K>::potrf("U", &mu, beta, &mu, &info);
+        if(info)
+            return fallback();
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            std::fill(beta + nu * (mu + 1) + 1, beta + (nu + 1) * mu, K());
+        if(i == 0) {
+            Wrapper<K>::template omatcopy<'N'>(mu, mu, beta, mu, rhs, ldh);
+            if(!guess)
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    norm[nu] = Blas<K>::nrm2(&mu, beta + nu * mu, &i__1);
+                    if(norm[nu] < HPDDM_EPS)
+                        norm[nu] = 1.0;
+                }
+        }
+        else {
+            std::fill_n(col, ldc * mu, K());
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(i > 1)
+                    for(unsigned short k = 0; k <= nu; ++k)
+                        col[mu + k * ldc + nu] = Wrapper<K>::conj(oldb[k + nu * mu]);
+                std::copy_n(alpha + nu * mu, mu, col + 2 * mu + nu * ldc);
+                std::copy_n(beta + nu * mu, nu + 1, col + 3 * mu + nu * ldc);
+            }
+            if(i > 2)
+                Lapack<K>::mqr("L", &(Wrapper<K>::transc), &ldh, &mu, &mu, H[0], &ldh, tau[0], col, &ldc, qwork, &lwork, &info);
+            if(i > 1)
+                Lapack<K>::mqr("L", &(Wrapper<K>::transc), &ldh, &mu, &mu, H[1], &ldh, tau[1], col + mu, &ldc, qwork, &lwork, &info);
+            std::swap(H[0], H[1]);
+            std::swap(tau[0], tau[1]);
+            Lapack<K>::geqrf(&ldh, &mu, col + 2 * mu, &ldc, tau[1], qwork, &lwork, &info);
+            Wrapper<K>::template omatcopy<'N'>(mu, ldh, col + 2 * mu, ldc, H[1], ldh);
+            Lapack<K>::mqr("L", &(Wrapper<K>::transc), &ldh, &mu, &mu, H[1], &ldh, tau[1], rhs, &ldh, qwork, &lwork, &info);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                if(std::abs(col[2 * mu + nu * (ldc + 1)]) < std::numeric_limits<underlying_type<K>>::min())
+                    return fallback();
+            if(!excluded && n) {
+                std::copy_n(v, dim, p2);
+                Blas<K>::gemm("N", "N", &n, &mu, &mu, &(Wrapper<K>::d__2), p1, &n, col + mu, &ldc, &(Wrapper<K>::d__1), p2, &n);
+                Blas<K>::gemm("N", "N", &n, &mu, &mu, &(Wrapper<K>::d__2), p, &n, col, &ldc, &(Wrapper<K>::d__1), p2, &n);
+                Blas<K>::trsm("R", "U", "N", "N", &n, &mu, &(Wrapper<K>::d__1), col + 2 * mu, &ldc, p2, &n);
+                Blas<K>::gemm("N", "N", &n, &mu, &mu, &(Wrapper<K>::d__1), p2, &n, rhs, &ldh, &(Wrapper<K>::d__1), x, &n);
+            }
+            std::swap(p, p1);
+            std::swap(p1, p2);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                std::copy_n(rhs + mu + nu * ldh, mu, rhs + nu * ldh);
+                std::fill_n(rhs + mu + nu * ldh, mu, K());
+            }
+        }
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            res[nu] = Blas<K>::nrm2(&mu, rhs + nu * ldh, &i__1);
+        checkConvergence<10>(id[0], i, i, tol, mu, norm, res, hasConverged, it);
+        if(std::find(hasConverged, hasConverged + mu, -it) == hasConverged + mu) {
+            converged = true;
+            break;
+        }
+        if(i == it)
+            break;
+        ++i;
+        std::copy_n(G + mu * mu, mu * mu, alpha);
+        Blas<K>::trsm("L", "U", &(Wrapper<K>::transc), "N", &mu, &mu, &(Wrapper<K>::d__1), beta, &mu, alpha, &mu);
+        Blas<K>::trsm("R", "U", "N", "N", &mu, &mu, &(Wrapper<K>::d__1), beta, &mu, alpha, &mu);
+        std::copy_n(G + 2 * mu * mu, mu * mu, C);
+        Blas<K>::trsm("L", "U", &(Wrapper<K>::transc), "N", &mu, &mu, &(Wrapper<K>::d__1), beta, &mu, C, &mu);
+        Blas<K>::trsm("R", "U", "N", "N", &mu, &mu, &(Wrapper<K>::d__1), oldb, &mu, C, &mu);
+        Blas<K>::trmm("R", "U", &(Wrapper<K>::transc), "N", &mu, &mu, &(Wrapper<K>::d__1), beta, &mu, C, &mu);
+        Blas<K>::axpy(&(info = mu * mu), &(Wrapper<K>::d__2), C, &i__1, alpha, &i__1);
+        if(!excluded && n) {
+            Wrapper<K>::template omatcopy<'C'>(mu, mu, beta, mu, C, mu);
+            Blas<K>::trsm("L", "U", "N", "N", &mu, &mu, &(Wrapper<K>::d__1), oldb, &mu, C, &mu);
+            Blas<K>::gemm("N", "N", &n, &mu, &mu, &(Wrapper<K>::d__1), r1, &n, C, &mu, &(Wrapper<K>::d__0), trash, &n);
+            std::copy_n(y, dim, v);
+            Blas<K>::trsm("R", "U", "N", "N", &n, &mu, &(Wrapper<K>::d__1), beta, &mu, v, &n);
+            Blas<K>::trsm("R", "U", "N", "N", &n, &mu, &(Wrapper<K>::d__1), beta, &mu, z, &n);
+            std::copy_n(alpha, mu * mu, C);
+            Blas<K>::trsm("L", "U", "N", "N", &mu, &mu, &(Wrapper<K>::d__1), beta, &mu, C, &mu);
+            std::copy_n(z, dim, r1);
+            Blas<K>::gemm("N", "N", &n, &mu, &mu, &(Wrapper<K>::d__2), r2, &n, C, &mu, &(Wrapper<K>::d__1), r1, &n);
+            Blas<K>::axpy(&dim, &(Wrapper<K>::d__2), trash, &i__1, r1, &i__1);
+        }
+        std::copy_n(beta, mu * mu, oldb);
+        std::swap(r1, r2);
+    }
+    convergence<10>(id[0], converged ? i : it + 1, it);
+    delete [] hasConverged;
+    delete [] norm;
+    delete [] work;
+    A.end(allocate);
+    return std::min(i, it);
+}
+} // HPDDM
+#endif // _HPDDM_MINRES_
@@ -252,6 +252,24 @@ class SuiteSparseSub {
         int*              _pattern;
         K*                      _W;
         K*                    _tmp;
+        /* Function: sparse
+         *  Returns a CHOLMOD sparse matrix sharing the arrays of the input matrix, to be freed with cholmod_free. */
+        cholmod_sparse* sparse(MatrixCSR<K>* const& A) const {
+            cholmod_sparse* M = static_cast<cholmod_sparse*>(cholmod_malloc(1, sizeof(cholmod_sparse), _c));
+            M->nrow = A->_m;
+            M->ncol = A->_n;
+            M->nzmax = A->_nnz;
+            M->sorted = 1;
+            M->packed = 1;
+            M->stype = 1;
+            M->xtype = Wrapper<K>::is_complex ? CHOLMOD_COMPLEX : CHOLMOD_REAL;
+            M->p = A->_ia;
+            M->i = A->_ja;
+            M->x = A->_a;
+            M->dtype = std::is_same<double, underlying_type<K>>::value ? CHOLMOD_DOUBLE : CHOLMOD_SINGLE;
+            M->itype = CHOLMOD_INT;
+            return M;
+        }
     public:
         SuiteSparseSub() : _L(), _c(), _b(), _x(), _Y(), _E(), _numeric(), _control(), _pattern(), _W(), _tmp() { }
         SuiteSparseSub(const SuiteSparseSub&) = delete;
@@ -284,19 +302,7 @@ class SuiteSparseSub {
                     _c = new cholmod_common;
                     cholmod_start(_c);
                 }
-                cholmod_sparse* M = static_cast<cholmod_sparse*>(cholmod_malloc(1, sizeof(cholmod_sparse), _c));
-                M->nrow = A->_m;
-                M->ncol = A->_n;
-                M->nzmax = A->_nnz;
-                M->sorted = 1;
-                M->packed = 1;
-                M->stype = 1;
-                M->xtype = Wrapper<K>::is_complex ? CHOLMOD_COMPLEX : CHOLMOD_REAL;
-                M->p = A->_ia;
-                M->i = A->_ja;
-                M->x = A->_a;
-                M->dtype = std::is_same<double, underlying_type<K>>::value ? CHOLMOD_DOUBLE : CHOLMOD_SINGLE;
-                M->itype = CHOLMOD_INT;
+                cholmod_sparse* M = sparse(A);
                 if(_L)
                     cholmod_free_factor(&_L, _c);
                 _L = cholmod_analyze(M, _c);
@@ -388,6 +394,22 @@ class SuiteSparseSub {
                 delete [] info;
             }
         }
+        /* Function: refactorize
+         *
+         *  Computes a numerical factorization of a matrix with the same sparsity pattern as the one previously passed to <SuiteSparseSub::numfact>, reusing the symbolic analysis of CHOLMOD.
+         *
+         * Parameter:
+         *    A              - Matrix to factorize. */
+        template<char N = HPDDM_NUMBERING>
+        void refactorize(MatrixCSR<K>* const& A) {
+            if(_c && _L) {
+                cholmod_sparse* M = sparse(A);
+                cholmod_factorize(M, _L, _c);
+                cholmod_free(1, sizeof(cholmod_sparse), M, _c);
+            }
+            else
+                numfact<N>(A);
+        }
         void solve(K* const x) const {
             if(_c) {
                 _b->ncol = 1;
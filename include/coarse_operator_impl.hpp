@@ -38,12 +38,12 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
     unsigned short p = opt.val<unsigned short>("master_p", 1);
 #ifndef DSUITESPARSE
     if(p > _sizeWorld / 2 && _sizeWorld > 1) {
-        p = opt["master_p"] = _sizeWorld / 2;
+        p = opt.set("master_p", _sizeWorld / 2);
         if(_rankWorld == 0)
             std::cout << "WARNING -- the number of master processes was set to a value greater than MPI_Comm_size / 2, the value has been reset to " << p << std::endl;
     }
 #else
-    p = opt["master_p"] = 1;
+    p = opt.set("master_p", 1);
 #endif
     if(p == 1) {
         MPI_Comm_dup(comm, &_scatterComm);
@@ -98,7 +98,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
 #endif
         else {
             if(T != 0)
-                opt["master_topology"] = 0;
+                opt.set("master_topology", 0);
             if(_rankWorld < (p - 1) * (_sizeWorld / p))
                 tmp = _sizeWorld / p;
             else
@@ -50,6 +50,84 @@ struct CustomOperator<MatrixCSR<K>, K> : EmptyOperator<K> {
     }
 };
 
+/* Class: Initial guess
+ *
+ *  A class that stores, for each prefix, the solutions of the last systems solved by <Iterative method::solve> to compute the initial guess of the next one, cf. -hpddm_initial_guess.
+ *
+ * Template Parameter:
+ *    K              - Scalar type. */
+template<class K>
+class InitialGuess : private Singleton {
+    private:
+        /* Variable: storage
+         *  Ring buffers of previous solutions, keyed by prefix, with their number of unknowns, number of right-hand sides, capacity, number of stored solves, and position of the next one. */
+        std::unordered_map<std::string, std::pair<K*, std::array<int, 5>>> _storage;
+        /* Variable: mutex
+         *  Mutex protecting <Initial guess::storage> when multiple threads solve concurrently with different prefixes. */
+        mutable std::mutex                                                _mutex;
+    public:
+        template<int N>
+        InitialGuess(Singleton::construct_key<N>) { }
+        ~InitialGuess() {
+            for(const auto& p : _storage)
+                delete [] p.second.first;
+            _storage.clear();
+        }
+        /* Function: destroy
+         *  Forgets all previous solutions associated to a prefix. */
+        void destroy(const std::string& key = "") {
+            std::lock_guard<std::mutex> lock(_mutex);
+            typename std::unordered_map<std::string, std::pair<K*, std::array<int, 5>>>::iterator it = _storage.find(key);
+            if(it != _storage.end()) {
+                delete [] it->second.first;
+                _storage.erase(it);
+            }
+        }
+        /* Function: push
+         *
+         *  Stores solutions, discarding the oldest ones if the window is full, or all of them if the dimensions changed.
+         *
+         * Parameters:
+         *    x              - Solution vectors.
+         *    n              - Number of unknowns.
+         *    mu             - Number of right-hand sides.
+         *    size           - Number of solves kept in the window.
+         *    key            - Prefix. */
+        void push(const K* const x, const int n, const int mu, const int size, const std::string& key = "") {
+            std::lock_guard<std::mutex> lock(_mutex);
+            typename std::unordered_map<std::string, std::pair<K*, std::array<int, 5>>>::iterator it = _storage.find(key);
+            if(it == _storage.end())
+                it = _storage.emplace(key, std::make_pair(nullptr, std::array<int, 5>())).first;
+            std::array<int, 5>& info = it->second.second;
+            if(!it->second.first || info[0] != n || info[1] != mu || info[2] != size) {
+                delete [] it->second.first;
+                it->second.first = new K[size * mu * n];
+                info = { { n, mu, size, 0, 0 } };
+            }
+            std::copy_n(x, mu * n, it->second.first + info[4] * mu * n);
+            info[3] = std::min(info[3] + 1, size);
+            info[4] = (info[4] + 1) % size;
+        }
+        /* Function: size
+         *  Returns the number of solves stored for a given prefix, or zero if their dimensions do not match. */
+        int size(const int n, const int mu, const std::string& key = "") const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            typename std::unordered_map<std::string, std::pair<K*, std::array<int, 5>>>::const_iterator it = _storage.find(key);
+            return it != _storage.cend() && it->second.second[0] == n && it->second.second[1] == mu ? it->second.second[3] : 0;
+        }
+        /* Function: recent
+         *  Returns the solution vectors of the j-th most recent solve stored for a given prefix, starting from zero. */
+        const K* recent(const int j, const std::string& key = "") const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const std::pair<K*, std::array<int, 5>>& p = _storage.at(key);
+            return p.first + ((p.second[4] - 1 - j + 2 * p.second[2]) % p.second[2]) * p.second[1] * p.second[0];
+        }
+        template<int N = 0>
+        static std::shared_ptr<InitialGuess> get() {
+            return Singleton::get<InitialGuess, N>();
+        }
+};
+
 /* Class: Iterative method
  *  A class that implements various iterative methods. */
 class IterativeMethod {
@@ -62,7 +140,7 @@ class IterativeMethod {
                 if(conv[nu] == -sentinel && ((tol > 0.0 && std::abs(res[nu]) / norm[nu] <= tol) || (tol < 0.0 && std::abs(res[nu]) <= -tol)))
                     conv[nu] = i;
             if(verbosity > 2) {
-                constexpr auto method = (T == 2 ? "CG" : (T == 4 ? "GCRODR" : "GMRES"));
+                constexpr auto method = (T == 2 ? "CG" : (T == 4 ? "GCRODR" : (T == 6 ? "PCG" : (T == 7 ? "BiCGStab" : (T == 8 ? "IDR" : (T == 9 ? "MINRES" : (T == 10 ? "BMINRES" : (T == 11 ? "ShiftedGMRES" : (T == 12 ? "ECG" : "GMRES")))))))));
                 unsigned short tmp[2] { 0, 0 };
                 underlying_type<K> beta = std::abs(res[0]);
                 for(unsigned short nu = 0; nu < mu; ++nu) {
@@ -136,35 +214,148 @@ class IterativeMethod {
         template<char T>
         static void convergence(const char verbosity, const unsigned short i, const unsigned short m) {
             if(verbosity) {
-                constexpr auto method = (T == 1 ? "BGMRES" : (T == 2 ? "CG" : (T == 3 ? "BCG" : (T == 4 ? "GCRODR" : (T == 5 ? "BGCRODR" : (T == 6 ? "PCG" : "GMRES"))))));
+                constexpr auto method = (T == 1 ? "BGMRES" : (T == 2 ? "CG" : (T == 3 ? "BCG" : (T == 4 ? "GCRODR" : (T == 5 ? "BGCRODR" : (T == 6 ? "PCG" : (T == 7 ? "BiCGStab" : (T == 8 ? "IDR" : (T == 9 ? "MINRES" : (T == 10 ? "BMINRES" : (T == 11 ? "ShiftedGMRES" : (T == 12 ? "ECG" : "GMRES"))))))))))));
                 if(i != m + 1)
                     std::cout << method << " converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
                 else
                     std::cout << method << " does not converges after " << m << " iteration" << (m > 1 ? "s" : "") << std::endl;
             }
         }
+        /* Function: snapshot
+         *  Returns the <OptionsSnapshot> of an operator, resolved with its prefix if it does not derive from <OptionsPrefix>. */
+        template<class Operator, typename std::enable_if<std::is_base_of<OptionsPrefix, Operator>::value>::type* = nullptr>
+        static const OptionsSnapshot& snapshot(const Operator& A) {
+            return A.snapshot();
+        }
+        template<class Operator, typename std::enable_if<!std::is_base_of<OptionsPrefix, Operator>::value>::type* = nullptr>
+        static OptionsSnapshot snapshot(const Operator& A) {
+            return OptionsSnapshot(A.prefix());
+        }
+        /* Function: initialGuess
+         *
+         *  Computes an initial guess from the solutions of the previous systems solved with the same prefix, cf. <Initial guess>. With -hpddm_initial_guess projection, the residual of the input guess is minimized over the span of these solutions, which costs one product with the operator per stored solve and a single global reduction. With -hpddm_initial_guess extrapolation, the input guess is replaced by the polynomial extrapolation of these solutions, assuming they are equally spaced. The methods which measure the tolerance against their first residual then use the preconditioned right-hand side instead, cf. <IterativeMethod::referenceNorm>. Substructuring methods ignore initial guesses.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Initial guess(es), updated in-place.
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool excluded, class Operator, class K>
+        static void initialGuess(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+            const std::string prefix = A.prefix();
+            const std::shared_ptr<InitialGuess<K>> guess = InitialGuess<K>::get();
+            const int n = excluded ? 0 : A.getDof();
+            int k = guess->size(n, mu, prefix);
+            MPI_Allreduce(MPI_IN_PLACE, &k, 1, MPI_INT, MPI_MIN, comm);
+            if(k == 0)
+                return;
+            if(snapshot(A).initial_guess == 2) {
+                const int dim = mu * n;
+                std::fill_n(x, dim, K());
+                K alpha = K(k);
+                for(int j = 0; j < k; ++j) {
+                    Blas<K>::axpy(&dim, &alpha, guess->recent(j, prefix), &i__1, x, &i__1);
+                    alpha *= -K(k - 1 - j) / K(j + 2);
+                }
+                return;
+            }
+            int p = k * mu;
+            const underlying_type<K>* const d = A.getScaling();
+            K* const work = new K[(2 * k + 1) * mu * n + k * mu * (k * mu + mu)];
+            K* const scal = work + (k + 1) * mu * n;
+            K* const G = scal + k * mu * n;
+            K* const r = G + p * p;
+            K* const res = work + k * mu * n;
+            int m = mu;
+            if(!excluded) {
+                for(int j = 0; j < k; ++j)
+                    A.GMV(guess->recent(j, prefix), work + j * mu * n, mu);
+                A.GMV(x, res, mu);
+                Blas<K>::axpby(mu * n, 1.0, b, 1, -1.0, res, 1);
+                Wrapper<K>::diag(n, d, work, scal, k * mu);
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &p, &p, &n, &(Wrapper<K>::d__1), scal, &n, work, &n, &(Wrapper<K>::d__0), G, &p);
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &p, &m, &n, &(Wrapper<K>::d__1), scal, &n, res, &n, &(Wrapper<K>::d__0), r, &p);
+            }
+            else
+                std::fill_n(G, p * (p + mu), K());
+            MPI_Allreduce(MPI_IN_PLACE, G, p * (p + mu), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            int info;
+            Lapack<K>::potrf("U", &p, G, &p, &info);
+            const int q = info > 0 ? info - 1 : p;
+            if(q > 0) {
+                Lapack<K>::potrs("U", &q, &m, G, &p, r, &p, &info);
+                for(int i = 0; i < q; ++i) {
+                    const K* const pt = guess->recent(i / mu, prefix) + (i % mu) * n;
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        Blas<K>::axpy(&n, r + i + nu * p, pt, &i__1, x + nu * n, &i__1);
+                }
+            }
+            if(snapshot(A).verbosity > 1) {
+                int rank;
+                MPI_Comm_rank(comm, &rank);
+                if(rank == 0)
+                    std::cout << " --- initial guess projected onto " << q << " previous solution" << (q > 1 ? "s" : "") << std::endl;
+            }
+            delete [] work;
+        }
+        /* Function: record
+         *  Forwards the number of iterations and the wall-clock time of a solve to an operator which keeps track of them, e.g., <Preconditioner::record>. */
+        template<class Operator>
+        static auto record(const Operator& A, const int& it, const double& time, int) -> decltype(A.record(it, time), void()) {
+            A.record(it, time);
+        }
+        template<class Operator>
+        static void record(const Operator&, const int&, const double&, long) { }
+        /* Function: mass
+         *  Applies the mass matrix of an operator which provides one, e.g., to solve shifted systems with <ShiftedGMRES>, or the identity otherwise. */
+        template<class Operator, class K>
+        static auto mass(const Operator& A, const K* const in, K* const out, const int& mu, int) -> decltype(A.mass(in, out, mu), void()) {
+            A.mass(in, out, mu);
+        }
+        template<class Operator, class K>
+        static void mass(const Operator& A, const K* const in, K* const out, const int& mu, long) {
+            std::copy_n(in, mu * A.getDof(), out);
+        }
+        /* Function: consistent
+         *  Makes the values of vectors duplicated on multiple processes consistent, which prevents rounding errors from being amplified by long recurrences, e.g., in <ShiftedGMRES>, if the operator provides a member function scaledExchange, cf. <Schwarz::scaledExchange>. */
+        template<class Operator, class K>
+        static auto consistent(const Operator& A, K* const x, const int& mu, int) -> decltype(A.scaledExchange(x, mu), void()) {
+            A.scaledExchange(x, mu);
+        }
+        template<class Operator, class K>
+        static void consistent(const Operator&, K* const, const int&, long) { }
+        /* Function: correction
+         *  Overrides the coarse correction of an operator which provides a member function setCoarseCorrection, cf. <Schwarz::setCoarseCorrection>, without modifying the options. */
+        template<class Operator>
+        static auto correction(const Operator& A, const char c, int) -> decltype(A.setCoarseCorrection(c), void()) {
+            A.setCoarseCorrection(c);
+        }
+        template<class Operator>
+        static void correction(const Operator&, const char, long) { }
         template<char T, class K>
-        static void options(const std::string& prefix, K* const d, int* const i, unsigned short* const m, char* const id) {
-            const Option& opt = *Option::get();
-            d[0] = opt.val(prefix + "tol", 1.0e-6);
-            m[0] = std::min(opt.val<short>(prefix + "max_it", 100), std::numeric_limits<short>::max());
-            id[0] = opt.val<char>(prefix + "verbosity", 0);
+        static void options(const OptionsSnapshot& opt, K* const d, int* const i, unsigned short* const m, char* const id) {
+            d[0] = opt.tol;
+            m[0] = opt.max_it;
+            id[0] = opt.verbosity;
             if(T == 1 || T == 5) {
-                d[1] = opt.val(prefix + "initial_deflation_tol", -1.0);
-                m[2] = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 1);
+                d[1] = opt.initial_deflation_tol;
+                m[2] = opt.enlarge;
             }
-            if(T == 0 || T == 1 || T == 4 || T == 5)
-                m[1] = std::min(static_cast<unsigned short>(std::numeric_limits<short>::max()), std::min(opt.val<unsigned short>(prefix + "gmres_restart", 40), m[0]));
-            if(T == 0 || T == 1 || T == 2 || T == 4 || T == 5)
-                id[1] = opt.val<char>(prefix + "variant", 1);
+            if(T == 0 || T == 1 || T == 4 || T == 5 || T == 11)
+                m[1] = std::min(opt.gmres_restart, m[0]);
+            if(T == 7 || T == 8)
+                m[1] = std::max(T == 7 ? opt.bicgstab_l : opt.idr_s, static_cast<unsigned short>(1));
+            if(T == 0 || T == 1 || T == 2 || T == 4 || T == 5 || T == 7 || T == 8)
+                id[1] = opt.variant;
             if(T == 0 || T == 3)
-                id[1 + (T == 0)] = opt.val<char>(prefix + (T == 0 ? "orthogonalization" : "qr"), 0);
+                id[1 + (T == 0)] = (T == 0 ? opt.orthogonalization : opt.qr);
             if(T == 1 || T == 4 || T == 5)
-                id[2] = opt.val<char>(prefix + "orthogonalization", 0) + 4 * opt.val<char>(prefix + "qr", 0);
+                id[2] = opt.orthogonalization + 4 * opt.qr;
             if(T == 4 || T == 5) {
-                *i = std::min(m[1] - 1, opt.val<int>(prefix + "recycle", 0));
-                id[3] = opt.val<char>(prefix + "recycle_target", 0);
-                id[4] = opt.val<char>(prefix + "recycle_strategy", 0) + 4 * (std::min(opt.val<unsigned short>(prefix + "recycle_same_system"), static_cast<unsigned short>(2)));
+                *i = std::min(m[1] - 1, opt.recycle);
+                id[3] = opt.recycle_target;
+                id[4] = opt.recycle_strategy + 4 * (std::min(opt.recycle_same_system, static_cast<unsigned short>(2)));
             }
             if(std::abs(d[0]) < std::numeric_limits<underlying_type<K>>::epsilon()) {
                 if(id[0])
@@ -388,6 +579,44 @@ class IterativeMethod {
             else
                 Wrapper<T>::diag(n, d, in);
         }
+        /* Function: referenceNorm
+         *
+         *  Computes the norms of the preconditioned right-hand sides, used as references for the relative tolerance by the methods which otherwise measure it against their first residual, so that an initial guess computed by <IterativeMethod::initialGuess> does not make the tolerance stricter.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand sides.
+         *    n              - Size of the vectors.
+         *    energy         - True to compute (b, M b)^1/2, as in <MINRES>, false to compute (M b, M b)^1/2, as in <CG>.
+         *    norm           - Norms, a single one if k is greater than 1.
+         *    mu             - Number of right-hand sides.
+         *    k              - Greater than 1 to compute the norm of the sum of the right-hand sides, as in <ECG>.
+         *    comm           - Global MPI communicator. */
+        template<bool excluded, class Operator, class K>
+        static void referenceNorm(const Operator& A, const K* const b, const int n, const bool energy, underlying_type<K>* const norm, const unsigned short mu, const unsigned short k, const MPI_Comm& comm) {
+            const unsigned short nrhs = k > 1 ? 1 : mu;
+            const int dim = n * nrhs;
+            K* const work = new K[3 * dim];
+            K* const z = work + dim;
+            const K* in = b;
+            if(k > 1) {
+                std::fill_n(work, n, K());
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    Blas<K>::axpy(&n, &(Wrapper<K>::d__1), b + nu * n, &i__1, work, &i__1);
+                in = work;
+            }
+            A.template apply<excluded>(in, z, nrhs, z + dim);
+            Wrapper<K>::diag(n, A.getScaling(), z, z + dim, nrhs);
+            for(unsigned short nu = 0; nu < nrhs; ++nu)
+                norm[nu] = std::real(Blas<K>::dot(&n, (energy ? in : z) + nu * n, &i__1, z + dim + nu * n, &i__1));
+            MPI_Allreduce(MPI_IN_PLACE, norm, nrhs, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < nrhs; ++nu) {
+                norm[nu] = std::sqrt(norm[nu]);
+                if(norm[nu] < HPDDM_EPS)
+                    norm[nu] = 1.0;
+            }
+            delete [] work;
+        }
         template<bool excluded, class Operator, class K>
         static bool initializeNorm(const Operator& A, const char variant, const K* const b, K* const x, K* const v, const int n, K* work, underlying_type<K>* const norm, const unsigned short mu, const unsigned short k) {
             bool allocate = A.template start<excluded>(b, x, mu);
@@ -667,11 +896,11 @@ class IterativeMethod {
                     std::copy_n(b + nu * n, n, sb + (j + k * nu) * n);
                 }
                 Option& opt = *Option::get();
-                opt[prefix + "enlarge_krylov_subspace"] = k;
+                opt.set(prefix + "enlarge_krylov_subspace", k);
                 if(mu > 1)
                     opt.remove(prefix + "initial_deflation_tol");
-                if(!opt.any_of(prefix + "krylov_method", { 1, 3, 5 })) {
-                    opt[prefix + "krylov_method"] = 1;
+                if(!opt.any_of(prefix + "krylov_method", { 1, 3, 5, 9, 10 })) {
+                    opt.set(prefix + "krylov_method", 1);
                     if(opt.val<char>(prefix + "verbosity", 0))
                         std::cout << "WARNING -- block iterative methods should be used when enlarging Krylov subspaces, now switching to BGMRES" << std::endl;
                 }
@@ -712,6 +941,73 @@ class IterativeMethod {
         static int GCRODR(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
         template<bool, class Operator, class K>
         static int BGCRODR(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
+        /* Function: ShiftedGMRES
+         *
+         *  Solves the family of shifted systems (A - shifts[i] M) x[i] = b, where M is the identity, or the mass matrix if the operator has a member function mass. A single search space is built with the preconditioner of A, and the residual of each shifted system is minimized over this space, so that any preconditioner may be used. The Arnoldi process generating this search space follows the unconverged shift with the largest residual, and starts over from the residual of another shift as soon as this one has converged. Each iteration requires one application of the preconditioner, one of A, one of M, and two global reductions, independently of the number of shifts. The balanced coarse correction is replaced by the additive one for the duration of the solve, since its initial projection only holds for A, without modifying the options. Convergence is checked for each shift, and the solutions of the shifts which have converged are no longer updated. Since the search space is restarted every -hpddm_gmres_restart iterations, as with <GMRES>, a shift for which restarted GMRES stagnates, e.g., one making A - shifts[i] M indefinite while the preconditioner is built for a definite A, prevents the solve from converging for that shift only, and a larger restart is then needed.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side.
+         *    x              - Solution vectors, one per shift.
+         *    k              - Number of shifts.
+         *    shifts         - Shifts.
+         *    comm           - Global MPI communicator. */
+        template<bool excluded = false, class Operator, class K>
+        static int ShiftedGMRES(const Operator& A, const K* const b, K* const x, const int& k, const K* const shifts, const MPI_Comm& comm);
+        /* Function: BiCGStab
+         *
+         *  Implements BiCGStab(l), whose memory footprint does not depend on the number of iterations. Each iteration requires two applications of the preconditioned operator and two global reductions, plus one more every l iterations for the minimal residual polynomial.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int BiCGStab(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
+        /* Function: IDR
+         *
+         *  Implements the biorthogonal variant of IDR(s), whose memory footprint does not depend on the number of iterations. Each iteration requires one application of the preconditioned operator and one global reduction.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int IDR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
+        /* Function: MINRES
+         *
+         *  Implements the preconditioned MINRES method for Hermitian, possibly indefinite, operators, whose memory footprint does not depend on the number of iterations. Each iteration requires one application of the operator, one application of the preconditioner, and one global reduction. The preconditioner must be Hermitian positive definite, so <GMRES> is used instead with nonsymmetric Schwarz methods or the deflated coarse correction, as in <CG>. BMINRES is the block variant, based on a block Lanczos process.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int MINRES(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
+        template<bool, class Operator, class K>
+        static int BMINRES(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
         /* Function: CG
          *
          *  Implements the CG method.
@@ -729,6 +1025,22 @@ class IterativeMethod {
         static int CG(const Operator& A, const K* const b, K* const x, const int&, const MPI_Comm& comm);
         template<bool, class Operator, class K>
         static int BCG(const Operator& A, const K* const b, K* const x, const int&, const MPI_Comm& comm);
+        /* Function: ECG
+         *
+         *  Implements the enlarged CG method, in which the right-hand side is split into multiple vectors, see <Subdomain::scatter>, and the residual is minimized in the A-norm over all resulting search directions at once. Search directions that have become linearly dependent or have converged are detected with a pivoted Cholesky factorization of their A-Gram matrix, and removed for all subsequent iterations, so that the cost of an iteration gets closer to that of the CG method when the solver approaches convergence. Each iteration requires two global reductions. <BCG> is used instead if the Krylov subspace is not enlarged, or if there are multiple right-hand sides.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Split right-hand side.
+         *    x              - Split solution vector.
+         *    mu             - Number of vectors of the splitting.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int ECG(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
         /* Function: PCG
          *
          *  Implements the projected CG method.
@@ -741,9 +1053,10 @@ class IterativeMethod {
          *    A              - Global operator.
          *    b              - Right-hand side.
          *    x              - Solution vector.
+         *    mu             - Number of right-hand sides.
          *    comm           - Global MPI communicator. */
         template<bool excluded = false, class Operator, class K>
-        static int PCG(const Operator& A, const K* const b, K* const x, const MPI_Comm& comm);
+        static int PCG(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
         template<bool excluded = false, class Operator = void, class K = double, typename std::enable_if<!is_substructuring_method<Operator>::value>::type* = nullptr>
         static int solve(const Operator& A, const K* const b, K* const x, const int& mu
 #if HPDDM_MPI
@@ -754,17 +1067,26 @@ class IterativeMethod {
 #endif
             std::ios_base::fmtflags ff(std::cout.flags());
             std::cout << std::scientific;
-            const std::string prefix = A.prefix();
-            Option& opt = *Option::get();
 #if HPDDM_MIXED_PRECISION
-            opt[prefix + "variant"] = 2;
+            Option::get()->set(A.prefix() + "variant", 2);
 #endif
-            unsigned short k = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 1);
+            unsigned short k = snapshot(A).enlarge;
             K* sx = nullptr;
             K* sb = nullptr;
+            const char guess = snapshot(A).initial_guess;
+            if(guess)
+                initialGuess<excluded>(A, b, x, mu, comm);
             preprocess<excluded>(A, b, sb, x, sx, mu, k, comm);
+#if HPDDM_MPI
+            const double time = MPI_Wtime();
+#endif
             int it;
-            switch(opt.val<char>(prefix + "krylov_method")) {
+            switch(snapshot(A).krylov_method) {
+                case 10: it = HPDDM::IterativeMethod::ECG<excluded>(A, sb, sx, k * mu, comm); break;
+                case 9:  it = HPDDM::IterativeMethod::BMINRES<excluded>(A, sb, sx, k * mu, comm); break;
+                case 8:  it = HPDDM::IterativeMethod::MINRES<excluded>(A, sb, sx, k * mu, comm); break;
+                case 7:  it = HPDDM::IterativeMethod::IDR<excluded>(A, sb, sx, k * mu, comm); break;
+                case 6:  it = HPDDM::IterativeMethod::BiCGStab<excluded>(A, sb, sx, k * mu, comm); break;
                 case 5:  it = HPDDM::IterativeMethod::BGCRODR<excluded>(A, sb, sx, k * mu, comm); break;
                 case 4:  it = HPDDM::IterativeMethod::GCRODR<excluded>(A, sb, sx, k * mu, comm); break;
                 case 3:  it = HPDDM::IterativeMethod::BCG<excluded>(A, sb, sx, k * mu, comm); break;
@@ -772,13 +1094,23 @@ class IterativeMethod {
                 case 1:  it = HPDDM::IterativeMethod::BGMRES<excluded>(A, sb, sx, k * mu, comm); break;
                 default: it = HPDDM::IterativeMethod::GMRES<excluded>(A, sb, sx, k * mu, comm);
             }
+#if HPDDM_MPI
+            record(A, it, MPI_Wtime() - time, 0);
+#endif
             postprocess<excluded>(A, b, sb, x, sx, mu, k);
+            if(guess)
+                InitialGuess<K>::get()->push(x, excluded ? 0 : A.getDof(), mu, snapshot(A).initial_guess_window, A.prefix());
             std::cout.flags(ff);
             return it;
         }
         template<bool excluded = false, class Operator = void, class K = double, typename std::enable_if<is_substructuring_method<Operator>::value>::type* = nullptr>
-        static int solve(const Operator& A, const K* const b, K* const x, const int&, const MPI_Comm& comm) {
-            return HPDDM::IterativeMethod::PCG<excluded>(A, b, x, comm);
+        static int solve(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+            if(snapshot(A).initial_guess && snapshot(A).verbosity)
+                std::cout << "WARNING -- substructuring methods do not support initial guesses, -hpddm_initial_guess is ignored" << std::endl;
+            const double time = MPI_Wtime();
+            const int it = HPDDM::IterativeMethod::PCG<excluded>(A, b, x, mu, comm);
+            record(A, it, MPI_Wtime() - time, 0);
+            return it;
         }
 };
 } // HPDDM
@@ -150,6 +150,9 @@ class MatrixCSR {
         ~MatrixCSR() {
             destroy();
         }
+        /* Function: getFree
+         *  Returns <MatrixCSR::free>. */
+        bool getFree() const { return _free; }
         /* Function: destroy
          *  Destroys the pointer <MatrixCSR::a>, <MatrixCSR::ia>, and <MatrixCSR::ja> using a custom deallocator if <MatrixCSR::free> is true. */
         void destroy(void (*dtor)(void*) = ::operator delete[]) {
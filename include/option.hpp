@@ -28,7 +28,7 @@
 #define HPDDM_CONCAT(NAME) "" HPDDM_PREFIX #NAME ""
 
 #include <stdlib.h>
-#include <string.h>
+#include <cstring>
 #include <stdexcept>
 #ifndef HPDDM_NO_REGEX
 #include <regex>
@@ -46,6 +46,9 @@ class Option : private Singleton {
         /* Variable: app
          *  Pointer to an unordered map that may store custom options as defined by the user in its application. */
         std::unordered_map<std::string, double>* _app;
+        /* Variable: mutex
+         *  Mutex protecting <Option::opt> when multiple threads solve concurrently. */
+        mutable std::recursive_mutex             _mutex;
         static void output(const std::vector<std::string>& list, size_t width) {
             std::cout << list.front() << std::setfill('-') << std::setw(width + 1) << std::right << "┐" << std::endl;
             for(std::vector<std::string>::const_iterator it = list.begin() + 1; it != list.end() - 1; ++it)
@@ -113,10 +116,19 @@ class Option : private Singleton {
         static std::shared_ptr<Option> get() {
             return Singleton::get<Option, N>();
         }
+        /* Function: revision
+         *  Returns a reference to a counter incremented each time <Option::opt> may be modified, used to invalidate instances of <OptionsSnapshot>. */
+        static std::atomic<unsigned int>& revision() {
+            static std::atomic<unsigned int> counter(1);
+            return counter;
+        }
         /* Function: app
          *  Returns a constant reference of <Option::app>. */
         std::unordered_map<std::string, double>& app() const { return *_app; }
-        bool set(const std::string& key) const { return _opt.find(key) != _opt.cend(); }
+        bool set(const std::string& key) const {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            return _opt.find(key) != _opt.cend();
+        }
         /* Function: remove
          *
          *  Removes a key from the unordered map <Option::opt>.
@@ -124,21 +136,39 @@ class Option : private Singleton {
          * Parameter:
          *    key            - Key to remove from <Option::opt>. */
         void remove(const std::string& key) {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
             std::unordered_map<std::string, double>::const_iterator it = _opt.find(key);
-            if(it != _opt.cend())
+            if(it != _opt.cend()) {
                 _opt.erase(it);
+                ++revision();
+            }
         }
         /* Function: val
          *  Returns the value of the key given as an argument, or use a default value if the key is not in <Option::opt>. */
         template<class T = double>
         T val(const std::string& key, T d = std::numeric_limits<T>::lowest()) const {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
             std::unordered_map<std::string, double>::const_iterator it = _opt.find(key);
             if(it == _opt.cend())
                 return d;
             else
                 return static_cast<T>(it->second);
         }
-        const double& operator[](const std::string& key) const {
+        /* Function: set
+         *
+         *  Sets the value of a key in <Option::opt>, then increments <Option::revision>, both under the lock, so that concurrent instances of <OptionsSnapshot> never see the new revision with the old value.
+         *
+         * Parameters:
+         *    key            - Key to set.
+         *    value          - New value of the key. */
+        double set(const std::string& key, const double value) {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            _opt[key] = value;
+            ++revision();
+            return value;
+        }
+        double operator[](const std::string& key) const {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
             try {
                 return _opt.at(key);
             }
@@ -147,7 +177,13 @@ class Option : private Singleton {
                 return _opt.cbegin()->second;
             }
         }
-        double& operator[](const std::string& key) { return _opt[key]; }
+        /* Function: operator[]
+         *  Returns a reference to the value of the key given as an argument, inserted if needed. The reference is written after the lock is released, so <Option::set> must be used instead when options may be accessed concurrently. */
+        double& operator[](const std::string& key) {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            ++revision();
+            return _opt[key];
+        }
         struct Arg {
             static bool positive(const std::string& opt, const std::string& s, bool verbose) {
                 if(!s.empty()) {
@@ -198,6 +234,7 @@ class Option : private Singleton {
          * Parameter:
          *    pre            - Prefix to look for. */
         std::string prefix(const std::string& pre, const bool internal = false) const {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
             if(!internal && !_app)
                 return std::string();
             std::unordered_map<std::string, double>::const_iterator pIt[2];
@@ -224,6 +261,7 @@ class Option : private Singleton {
          *    list           - List of values to search for. */
         template<class T>
         bool any_of(const std::string& key, std::initializer_list<T> list) const {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
             std::unordered_map<std::string, double>::const_iterator it = _opt.find(key);
             return (it != _opt.cend() && std::any_of(list.begin(), list.end(), [&](const T& t) { return t == static_cast<T>(it->second); }));
         }
@@ -274,6 +312,9 @@ class Option : private Singleton {
         int parse(std::vector<std::string>&, bool display = true, const Container& reg = { });
         template<bool internal, class T>
         bool insert(const T& option, std::string& str, const std::string& arg) {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            if(internal)
+                ++revision();
             std::string::size_type n = str.find("=");
             bool sep = true;
             std::string val;
@@ -425,11 +466,74 @@ class Option : private Singleton {
         }
 };
 
+/* Class: OptionsSnapshot
+ *  A structure holding the typed values of the options read by iterative methods and preconditioners at each solve or application, resolved once for a given prefix and revision of <Option>. */
+struct OptionsSnapshot {
+    double                          tol;
+    double        initial_deflation_tol;
+    int                         recycle;
+    unsigned short               max_it;
+    unsigned short        gmres_restart;
+    unsigned short              enlarge;
+    unsigned short  recycle_same_system;
+    unsigned short initial_guess_window;
+    unsigned short           bicgstab_l;
+    unsigned short                idr_s;
+    unsigned short schwarz_polynomial_degree;
+    char                      verbosity;
+    char                  krylov_method;
+    char                        variant;
+    char              orthogonalization;
+    char                             qr;
+    char                 recycle_target;
+    char               recycle_strategy;
+    char                 schwarz_method;
+    char      schwarz_coarse_correction;
+    char   schwarz_multiplicative_sweep;
+    char             schwarz_polynomial;
+    char                  initial_guess;
+    char           reuse_preconditioner;
+    OptionsSnapshot() { }
+    explicit OptionsSnapshot(const std::string& prefix) {
+        const Option& opt = *Option::get();
+        tol = opt.val(prefix + "tol", 1.0e-6);
+        initial_deflation_tol = opt.val(prefix + "initial_deflation_tol", -1.0);
+        recycle = opt.val<int>(prefix + "recycle", 0);
+        max_it = std::min(opt.val<short>(prefix + "max_it", 100), std::numeric_limits<short>::max());
+        gmres_restart = std::min(opt.val<unsigned short>(prefix + "gmres_restart", 40), static_cast<unsigned short>(std::numeric_limits<short>::max()));
+        enlarge = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 1);
+        recycle_same_system = opt.val<unsigned short>(prefix + "recycle_same_system");
+        verbosity = opt.val<char>(prefix + "verbosity", 0);
+        krylov_method = opt.val<char>(prefix + "krylov_method", 0);
+        variant = opt.val<char>(prefix + "variant", 1);
+        orthogonalization = opt.val<char>(prefix + "orthogonalization", 0);
+        qr = opt.val<char>(prefix + "qr", 0);
+        recycle_target = opt.val<char>(prefix + "recycle_target", 0);
+        recycle_strategy = opt.val<char>(prefix + "recycle_strategy", 0);
+        schwarz_method = opt.val<char>(prefix + "schwarz_method", -1);
+        schwarz_coarse_correction = opt.val<char>(prefix + "schwarz_coarse_correction", -1);
+        schwarz_multiplicative_sweep = opt.val<char>(prefix + "schwarz_multiplicative_sweep", 0);
+        schwarz_polynomial = opt.val<char>(prefix + "schwarz_polynomial", 0);
+        schwarz_polynomial_degree = opt.val<unsigned short>(prefix + "schwarz_polynomial_degree", 0);
+        bicgstab_l = opt.val<unsigned short>(prefix + "bicgstab_l", 2);
+        idr_s = opt.val<unsigned short>(prefix + "idr_s", 4);
+        initial_guess = opt.val<char>(prefix + "initial_guess", 0);
+        reuse_preconditioner = opt.val<char>(prefix + "reuse_preconditioner", 0);
+        initial_guess_window = std::max(opt.val<unsigned short>(prefix + "initial_guess_window", 3), static_cast<unsigned short>(1));
+    }
+};
+
 class OptionsPrefix {
     protected:
-        char* _prefix;
+        char*                    _prefix;
+        /* Variable: snapshot
+         *  Values of the options with the current prefix, cf. <OptionsPrefix::snapshot>. */
+        mutable OptionsSnapshot _snapshot;
+        /* Variable: revision
+         *  Revision of <Option> when <OptionsPrefix::snapshot> was last resolved, zero if it is out of date. */
+        mutable unsigned int    _revision;
     public:
-        OptionsPrefix() : _prefix() { };
+        OptionsPrefix() : _prefix(), _snapshot(), _revision() { };
         ~OptionsPrefix() {
             delete [] _prefix;
         }
@@ -438,6 +542,17 @@ class OptionsPrefix {
                 delete [] _prefix;
             _prefix = new char[std::strlen(prefix) + 1];
             std::strcpy(_prefix, prefix);
+            _revision = 0;
+        }
+        /* Function: snapshot
+         *  Returns a constant reference to <OptionsPrefix::snapshot>, resolved again only if <Option> has been modified since. */
+        const OptionsSnapshot& snapshot() const {
+            const unsigned int revision = Option::revision();
+            if(_revision != revision) {
+                _snapshot = OptionsSnapshot(prefix());
+                _revision = revision;
+            }
+            return _snapshot;
         }
         void setPrefix(const std::string& prefix) {
             if(prefix.size())
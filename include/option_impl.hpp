@@ -33,6 +33,7 @@ template<bool recursive, class Container>
 inline int Option::parse(std::vector<std::string>& args, bool display, const Container& reg) {
     if(args.size() == 0 && reg.size() == 0)
         return 0;
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     std::vector<std::tuple<std::string, std::string, std::function<bool(std::string&, const std::string&, bool)>>> option {
         std::forward_as_tuple("help", "Display available options", Arg::anything),
         std::forward_as_tuple("version", "Display information about HPDDM", Arg::anything),
@@ -40,7 +41,7 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
         std::forward_as_tuple("tol=<1.0e-6>", "Relative decrease in residual norm", Arg::numeric),
         std::forward_as_tuple("max_it=<100>", "Maximum number of iterations", Arg::positive),
         std::forward_as_tuple("verbosity(=<integer>)", "Level of output (higher means more displayed information)", Arg::anything),
-        std::forward_as_tuple("reuse_preconditioner=(0|1)", "Do not factorize again the local matrices when solving subsequent systems", Arg::argument),
+        std::forward_as_tuple("reuse_preconditioner=(0|1|adaptive)", "Do not factorize again the local matrices when solving subsequent systems, or only when the growth of the number of iterations outweighs the setup costs", Arg::argument),
         std::forward_as_tuple("local_operators_not_spd=(0|1)", "Assume local operators are not positive definite", Arg::argument),
         std::forward_as_tuple("orthogonalization=(cgs|mgs)", "Classical (faster) or Modified (more robust) Gram-Schmidt process", Arg::argument),
 #ifndef HPDDM_NO_REGEX
@@ -48,24 +49,40 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
 #else
         std::forward_as_tuple("dump_local_matrices=<output_file>", "Save all local matrices to disk", Arg::argument),
 #endif
-        std::forward_as_tuple("krylov_method=(gmres|bgmres|cg|bcg|gcrodr|bgcrodr)", "(Block) Generalized Minimal Residual Method, (Block) Conjugate Gradient, or (Block) Generalized Conjugate Residual Method With Inner Orthogonalization and Deflated Restarting", Arg::argument),
+        std::forward_as_tuple("krylov_method=(gmres|bgmres|cg|bcg|gcrodr|bgcrodr|bicgstab|idr|minres|bminres|ecg)", "(Block) Generalized Minimal Residual Method, (Block) Conjugate Gradient, (Block) Generalized Conjugate Residual Method With Inner Orthogonalization and Deflated Restarting, BiCGStab(l), IDR(s), (Block) Minimal Residual Method, or Enlarged Conjugate Gradient", Arg::argument),
         std::forward_as_tuple("enlarge_krylov_subspace=<val>", "Split the initial right-hand side into multiple vectors", Arg::positive),
         std::forward_as_tuple("gmres_restart=<40>", "Maximum number of Arnoldi vectors generated per cycle", Arg::positive),
+        std::forward_as_tuple("bicgstab_l=<2>", "Degree of the minimal residual polynomial in BiCGStab(l)", Arg::positive),
+        std::forward_as_tuple("idr_s=<4>", "Dimension of the shadow space in IDR(s)", Arg::positive),
         std::forward_as_tuple("variant=(left|right|flexible)", "Left, right, or variable preconditioning", Arg::argument),
         std::forward_as_tuple("qr=(cholqr|cgs|mgs)", "Distributed QR factorizations computed with Cholesky QR, Classical or Modified Gram-Schmidt process", Arg::argument),
         std::forward_as_tuple("initial_deflation_tol=<val>", "Tolerance when deflating right-hand sides inside Block GMRES or Block GCRODR", Arg::numeric),
         std::forward_as_tuple("recycle=<val>", "Number of harmonic Ritz vectors to compute", Arg::positive),
         std::forward_as_tuple("recycle_same_system=(0|1)", "Assume the system is the same as the one for which Ritz vectors have been computed", Arg::argument),
         std::forward_as_tuple("recycle_strategy=(A|B)", "Generalized eigenvalue problem to solve for recycling", Arg::argument),
+        std::forward_as_tuple("initial_guess=(none|projection|extrapolation)", "Minimize the residual of the initial guess over the span of the previous solutions, or extrapolate them", Arg::argument),
+        std::forward_as_tuple("initial_guess_window=<3>", "Number of previous solutions used to compute the initial guess", Arg::positive),
         std::forward_as_tuple("recycle_target=(SM|LM|SR|LR|SI|LI)", "Criterion to select harmonic Ritz vectors", Arg::argument),
 #if HPDDM_SCHWARZ
         std::forward_as_tuple("", "", [](std::string&, const std::string&, bool) { std::cout << "\n Overlapping Schwarz methods options:"; return true; }),
-        std::forward_as_tuple("schwarz_method=(ras|oras|soras|asm|osm|none)", "Symmetric or not, Optimized or Additive, Restricted or not", Arg::argument),
+        std::forward_as_tuple("schwarz_method=(ras|oras|soras|asm|osm|none|rms)", "Symmetric or not, Optimized, Additive or Multiplicative, Restricted or not", Arg::argument),
+        std::forward_as_tuple("schwarz_multiplicative_sweep=(forward|symmetric)", "Sweep over the colors of the subdomains once, or forward and backward, in the Restricted Multiplicative Schwarz method", Arg::argument),
         std::forward_as_tuple("schwarz_coarse_correction=(deflated|additive|balanced)", "Switch to a multilevel preconditioner", Arg::argument),
+        std::forward_as_tuple("schwarz_polynomial=(gmres|chebyshev)", "Roots of the polynomial preconditioner, harmonic Ritz values of the preconditioned operator, or roots of the Chebyshev polynomial on an estimate of its spectrum", Arg::argument),
+        std::forward_as_tuple("schwarz_polynomial_degree=<val>", "Degree of the residual polynomial of a polynomial preconditioner built on top of the Schwarz preconditioner, trading global reductions of iterative methods for local solves and exchanges with neighbors", Arg::integer),
+        std::forward_as_tuple("schwarz_local_subdomains=<val>", "Number of local subdomains per process, split along contiguous ranges of unknowns, factorized and solved concurrently by OpenMP tasks", Arg::integer),
+        std::forward_as_tuple("schwarz_local_overlap=<1>", "Number of layers of unknowns added to each local subdomain", Arg::integer),
 #endif
 #if HPDDM_FETI || HPDDM_BDD
         std::forward_as_tuple("", "", [](std::string&, const std::string&, bool) { std::cout << "\n Substructuring methods options:"; return true; }),
         std::forward_as_tuple("substructuring_scaling=(multiplicity|stiffness|coefficient)", "Type of scaling used for the preconditioner", Arg::argument),
+        std::forward_as_tuple("substructuring_compression=<val>", "Tolerance for storing explicit local Schur complements in block low-rank format", Arg::numeric),
+        std::forward_as_tuple("substructuring_kernel_tol=<val>", "Relative tolerance on the pivots of the Cholesky factorizations of the local Schur complements used to detect the kernel of floating subdomains, nonpositive values for the square root of the machine epsilon", Arg::numeric),
+        std::forward_as_tuple("substructuring_local_subdomains=<val>", "Number of local subdomains per process, split along contiguous ranges of unknowns, whose interior problems are solved concurrently by OpenMP threads", Arg::integer),
+#endif
+#if HPDDM_FETI
+        std::forward_as_tuple("feti_cluster_size=<val>", "Number of consecutive subdomains per cluster for hybrid FETI, -1 to cluster subdomains by compute node", Arg::integer),
+        std::forward_as_tuple("feti_adaptive=<val>", "Number of PCG iterations after which the Dirichlet preconditioner is used instead of the cheaper one if it is estimated to be faster", Arg::integer),
 #endif
 #if defined(EIGENSOLVER) || HPDDM_FETI || HPDDM_BDD
         std::forward_as_tuple("eigensolver_tol=<1.0e-6>", "Tolerance for computing eigenvectors by ARPACK or LAPACK", Arg::numeric),
@@ -74,6 +91,11 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
         std::forward_as_tuple("geneo_threshold=<eps>", "Threshold for selecting local eigenvectors for adaptive methods", Arg::numeric),
         std::forward_as_tuple("geneo_force_uniformity=(0|1)", "Ensure that the number of local eigenvectors is the same for all subdomains", Arg::argument),
 #endif
+#if HPDDM_FETI || HPDDM_BDD
+        std::forward_as_tuple("geneo_dense_solver=(tridiagonal|subspace)", "Full tridiagonal reduction or Chebyshev-filtered subspace iteration for the dense local eigenvalue problems of substructuring methods", Arg::argument),
+        std::forward_as_tuple("geneo_chunk_size=<val>", "Maximum number of scalars per message when exchanging local Schur complements, so that they are summed while the remaining chunks are in flight", Arg::integer),
+        std::forward_as_tuple("geneo_transfer=(full|reduced)", "Exchange local Schur complements in working or single precision", Arg::argument),
+#endif
 #if defined(SUBDOMAIN) || defined(COARSEOPERATOR)
 #ifndef HPDDM_NO_REGEX
 #if defined(DMKL_PARDISO) || defined(MKL_PARDISOSUB)
@@ -70,6 +70,45 @@ class Preconditioner : public Subdomain<K> {
         /* Variable: uc
          *  Workspace array of size <Coarse operator::local>. */
         mutable K*         _uc;
+        /* Variable: reuse
+         *  Number of calls to <Schwarz::callNumfact> since the last factorization of <Preconditioner::s> when -hpddm_reuse_preconditioner is set, zero otherwise. */
+        unsigned short  _reuse;
+        /* Variable: setup
+         *  Wall-clock times of the last factorization of <Preconditioner::s>, construction of <Preconditioner::co>, and computation of <Preconditioner::ev>, used when -hpddm_reuse_preconditioner is set to adaptive. */
+        double        _setup[3];
+        /* Variable: history
+         *  Number of iterations and wall-clock time of the first solve since the last refresh, followed by the time lost by subsequent solves because of the growth of the number of iterations, cf. <Preconditioner::record>. */
+        mutable double _history[3];
+        /* Variable: refresh
+         *  Components that should be refreshed, cf. <Preconditioner::refresh>. */
+        mutable unsigned short _refresh;
+        /* Function: refreshed
+         *
+         *  Records the setup time of a component of the preconditioner and resets the history of solves.
+         *
+         * Parameters:
+         *    i              - Index of the component in <Preconditioner::setup>.
+         *    time           - Wall-clock time spent refreshing the component. */
+        void refreshed(const unsigned short i, const double time) {
+            _setup[i] = time;
+            _refresh &= ~(1 << i);
+            std::fill_n(_history, 3, 0.0);
+        }
+        /* Function: refactorize
+         *
+         *  Computes a numerical factorization of a matrix with the same sparsity pattern as the one previously factorized by a solver, reusing its symbolic analysis when the solver provides a refactorize method, or calling its numfact method otherwise.
+         *
+         * Parameters:
+         *    s              - Solver.
+         *    A              - Matrix to factorize. */
+        template<char N, class T>
+        static auto refactorize(T& s, MatrixCSR<K>* const& A, int) -> decltype(s.template refactorize<N>(A), void()) {
+            s.template refactorize<N>(A);
+        }
+        template<char N, class T>
+        static void refactorize(T& s, MatrixCSR<K>* const& A, long) {
+            s.template numfact<N>(A);
+        }
         /* Function: buildTwo
          *
          *  Assembles and factorizes the coarse operator.
@@ -121,6 +160,7 @@ class Preconditioner : public Subdomain<K> {
                 else
                     ret = _co->template construction<0, excluded>(Operator(*B, allUniform[0], (allUniform[1] << 12) + allUniform[0]), comm);
                 construction = MPI_Wtime() - construction;
+                refreshed(1, construction);
                 if(_co->getRank() == 0 && opt.val<char>(prefix + "verbosity", 0) > 1) {
                     std::stringstream ss;
                     ss << std::setprecision(2) << construction;
@@ -149,7 +189,7 @@ class Preconditioner : public Subdomain<K> {
             _uc = new K[mu * _co->getSizeRHS()];
         }
     public:
-        Preconditioner() : _co(), _ev(), _uc() { }
+        Preconditioner() : _co(), _ev(), _uc(), _reuse(), _setup(), _history(), _refresh() { }
         Preconditioner(const Preconditioner&) = delete;
         ~Preconditioner() {
             delete _co;
@@ -176,11 +216,45 @@ class Preconditioner : public Subdomain<K> {
         void destroySolver() {
             using type = alias<Solver<K>>;
             _s.~type();
-            const std::string prefix = super::prefix();
-            Option& opt = *Option::get();
-            if(opt.val<unsigned short>(prefix + "reuse_preconditioner") >= 1)
-                opt[prefix + "reuse_preconditioner"] = 1;
+            _reuse = 0;
         }
+        /* Function: record
+         *
+         *  Updates the history of solves when -hpddm_reuse_preconditioner is set to adaptive. The time lost by a solve is the number of iterations in excess of the first solve since the last refresh, times the wall-clock time per iteration of that first solve. Once the accumulated time lost exceeds the setup time of a component, in the order of <Preconditioner::setup>, it is marked for refresh. The decision is taken collectively so that all processes agree on <Preconditioner::refresh>. It is called after each solve with <Schwarz> methods, and after each <Iterative method::PCG> with <Schur> methods, for which only the factorization of the local solver in <Schur::callNumfact> and the construction of the coarse operator are timed.
+         *
+         * Parameters:
+         *    it             - Number of iterations of the solve.
+         *    time           - Wall-clock time of the solve. */
+        void record(const int& it, const double& time) const {
+            const OptionsSnapshot& opt = super::snapshot();
+            if(opt.reuse_preconditioner != 2)
+                return;
+            double max[4] = { 0.0, _setup[0], _setup[1], _setup[2] };
+            if(_history[0] < 0.5) {
+                _history[0] = std::max(1, it);
+                _history[1] = time;
+            }
+            else
+                max[0] = _history[2] += std::max(0.0, it - _history[0]) * _history[1] / _history[0];
+            MPI_Allreduce(MPI_IN_PLACE, max, 4, MPI_DOUBLE, MPI_MAX, super::_communicator);
+            double cost = 0.0;
+            for(unsigned short i = 0; i < 3; ++i)
+                if(max[i + 1] > 0.0) {
+                    cost += max[i + 1];
+                    if(max[0] > cost)
+                        _refresh |= 1 << i;
+                }
+            if(_refresh && opt.verbosity > 1) {
+                int rank;
+                MPI_Comm_rank(super::_communicator, &rank);
+                if(rank == 0)
+                    std::cout << " --- time lost since the last refresh of the preconditioner: " << max[0] << "s, refresh requested (" << _refresh << ")" << std::endl;
+            }
+        }
+        /* Function: refresh
+         *
+         *  Returns the components that should be refreshed when -hpddm_reuse_preconditioner is set to adaptive, as a bitwise combination of 1 for <Preconditioner::s>, which is then factorized again by the next call to <Schwarz::callNumfact>, 2 for <Preconditioner::co>, and 4 for <Preconditioner::ev>. */
+        unsigned short refresh() const { return _refresh; }
         /* Function: callSolve
          *
          *  Applies <Preconditioner::s> to multiple right-hand sides in-place.
@@ -41,67 +41,454 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
     private:
         /* Function: exchangeSchurComplement
          *
-         *  Exchanges the local Schur complements <Schur::schur> to form an explicit restriction of the global Schur complement.
+         *  Exchanges the local Schur complements <Schur::schur> to form an explicit restriction of the global Schur complement. Blocks are streamed in chunks of at most -hpddm_geneo_chunk_size scalars, which are summed into the restriction as soon as they arrive.
          *
-         * Template Parameter:
+         * Template Parameters:
          *    L              - 'S'ymmetric or 'G'eneral transfer of the local Schur complements.
+         *    T              - Scalar type used for the transfer.
          *
          * Parameters:
          *    send           - Buffer for sending the local Schur complement.
          *    recv           - Buffer for receiving the local Schur complement of each neighboring subdomains.
-         *    res            - Restriction of the global Schur complement. */
-        template<char L>
-        void exchangeSchurComplement(K* const* const& send, K* const* const& recv, K* const& res) const {
-            if(send && recv && res) {
-                if(L == 'S')
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        MPI_Irecv(recv[i], (Subdomain<K>::_map[i].second.size() * (Subdomain<K>::_map[i].second.size() + 1)) / 2, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                            for(unsigned int k = j; k < Subdomain<K>::_map[i].second.size(); ++k) {
-                                if(Subdomain<K>::_map[i].second[j] < Subdomain<K>::_map[i].second[k])
-                                    send[i][Subdomain<K>::_map[i].second.size() * j - (j * (j + 1)) / 2 + k] = _schur[Subdomain<K>::_map[i].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[k]];
-                                else
-                                    send[i][Subdomain<K>::_map[i].second.size() * j - (j * (j + 1)) / 2 + k] = _schur[Subdomain<K>::_map[i].second[k] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[j]];
-                            }
-                        MPI_Isend(send[i], (Subdomain<K>::_map[i].second.size() * (Subdomain<K>::_map[i].second.size() + 1)) / 2, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+         *    res            - Restriction of the global Schur complement.
+         *    A              - Local Schur complement expanded while the messages are in flight (optional).
+         *    rq             - Requests of the receives followed by the requests of the sends. */
+        template<char L, class T>
+        void exchangeSchurComplement(K* const* const& send, K* const* const& recv, K* const& res, K* const& A, std::vector<MPI_Request>& rq) const {
+            const int chunk = Option::get()->val<int>(super::prefix("geneo_chunk_size"), 0) > 0 ? Option::get()->val<int>(super::prefix("geneo_chunk_size")) : std::numeric_limits<int>::max();
+            std::vector<unsigned int> first(Subdomain<K>::_map.size() + 1);
+            first[0] = 0;
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                const unsigned int n = Subdomain<K>::_map[i].second.size();
+                first[i + 1] = first[i] + ((L == 'S' ? (n * (n + 1)) / 2 : n * n) + chunk - 1) / chunk;
+            }
+            rq.resize(2 * first.back());
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                const unsigned int n = Subdomain<K>::_map[i].second.size();
+                const unsigned int size = (L == 'S' ? (n * (n + 1)) / 2 : n * n);
+                T* const r = reinterpret_cast<T*>(recv[i]);
+                for(unsigned int c = first[i]; c < first[i + 1]; ++c) {
+                    const unsigned int offset = (c - first[i]) * chunk;
+                    MPI_Irecv(r + offset, std::min(size - offset, static_cast<unsigned int>(chunk)), Wrapper<T>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, rq.data() + c);
+                }
+                T* const s = reinterpret_cast<T*>(send[i]);
+                unsigned int c = first[i];
+                for(unsigned int j = 0; j < n; ++j) {
+                    const unsigned int offset = (L == 'S' ? n * j - (j * (j + 1)) / 2 : n * j);
+                    for(unsigned int k = (L == 'S' ? j : 0); k < n; ++k) {
+                        if(Subdomain<K>::_map[i].second[j] < Subdomain<K>::_map[i].second[k])
+                            s[offset + k] = static_cast<T>(schurEntry(Subdomain<K>::_map[i].second[k], Subdomain<K>::_map[i].second[j]));
+                        else
+                            s[offset + k] = static_cast<T>(schurEntry(Subdomain<K>::_map[i].second[j], Subdomain<K>::_map[i].second[k]));
                     }
-                else
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        MPI_Irecv(recv[i], Subdomain<K>::_map[i].second.size() * Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                            for(unsigned int k = 0; k < Subdomain<K>::_map[i].second.size(); ++k) {
-                                if(Subdomain<K>::_map[i].second[j] < Subdomain<K>::_map[i].second[k])
-                                    send[i][j * Subdomain<K>::_map[i].second.size() + k] = _schur[Subdomain<K>::_map[i].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[k]];
-                                else
-                                    send[i][j * Subdomain<K>::_map[i].second.size() + k] = _schur[Subdomain<K>::_map[i].second[k] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[j]];
-                            }
-                        MPI_Isend(send[i], Subdomain<K>::_map[i].second.size() * Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                    while(c < first[i + 1] && ((c - first[i] + 1) * static_cast<unsigned long long>(chunk) <= offset + n || j == n - 1)) {
+                        const unsigned int begin = (c - first[i]) * chunk;
+                        MPI_Isend(s + begin, std::min(size - begin, static_cast<unsigned int>(chunk)), Wrapper<T>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, rq.data() + first.back() + c++);
                     }
-                Blas<K>::lacpy("L", &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), _schur, &(Subdomain<K>::_dof), res, &(Subdomain<K>::_dof));
-                if(L == 'S')
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        int index;
-                        MPI_Waitany(Subdomain<K>::_map.size(), Subdomain<K>::_rq, &index, MPI_STATUS_IGNORE);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[index].second.size(); ++j) {
-                            for(unsigned int k = 0; k < j; ++k)
-                                if(Subdomain<K>::_map[index].second[j] <= Subdomain<K>::_map[index].second[k])
-                                    res[Subdomain<K>::_map[index].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[index].second[k]] += recv[index][Subdomain<K>::_map[index].second.size() * k - (k * (k + 1)) / 2 + j];
-                            for(unsigned int k = j; k < Subdomain<K>::_map[index].second.size(); ++k)
-                                if(Subdomain<K>::_map[index].second[j] <= Subdomain<K>::_map[index].second[k])
-                                    res[Subdomain<K>::_map[index].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[index].second[k]] += recv[index][Subdomain<K>::_map[index].second.size() * j - (j * (j + 1)) / 2 + k];
+                }
+            }
+            expandSchurComplement(res);
+            if(A)
+                expandSchurComplement(A);
+            for(unsigned int c = 0; c < first.back(); ++c) {
+                int index;
+                MPI_Waitany(first.back(), rq.data(), &index, MPI_STATUS_IGNORE);
+                const unsigned short i = std::distance(first.cbegin(), std::upper_bound(first.cbegin(), first.cend(), index)) - 1;
+                const unsigned int n = Subdomain<K>::_map[i].second.size();
+                const unsigned int begin = (index - first[i]) * chunk;
+                const unsigned int end = std::min(L == 'S' ? (n * (n + 1)) / 2 : n * n, begin + chunk);
+                const T* const r = reinterpret_cast<const T*>(recv[i]);
+                for(unsigned int j = 0; j < n; ++j) {
+                    const unsigned int offset = (L == 'S' ? n * j - (j * (j + 1)) / 2 : n * j);
+                    if(offset + n <= begin)
+                        continue;
+                    if(offset + (L == 'S' ? j : 0) >= end)
+                        break;
+                    for(unsigned int k = std::max(L == 'S' ? j : 0, begin > offset ? begin - offset : 0); k < n && offset + k < end; ++k) {
+                        const int a = Subdomain<K>::_map[i].second[j];
+                        const int b = Subdomain<K>::_map[i].second[k];
+                        if(L == 'S')
+                            res[std::min(a, b) * Subdomain<K>::_dof + std::max(a, b)] += static_cast<K>(r[offset + k]);
+                        else if(a <= b)
+                            res[a * Subdomain<K>::_dof + b] += static_cast<K>(r[offset + k]);
+                    }
+                }
+            }
+        }
+        /* Function: subspaceIteration
+         *
+         *  Computes the lowest eigenpairs of a dense Hermitian matrix using a Chebyshev-filtered subspace iteration, so that only products with a block of vectors of size O(nu) are needed instead of a full tridiagonal reduction.
+         *
+         * Parameters:
+         *    n              - Number of rows of the matrix.
+         *    A              - Dense matrix, only its lower triangular part is referenced on input, its strictly upper triangular part is overwritten on output.
+         *    nu             - Number of eigenpairs requested.
+         *    tol            - Tolerance on the residuals relative to the norm of the matrix.
+         *    ev             - Array of size n x nu storing the eigenvectors on output.
+         *    evr            - Array of size nu storing the eigenvalues in ascending order on output.
+         *
+         * Returns: false if the iteration did not converge, in which case a full tridiagonal reduction should be used instead. */
+        static bool subspaceIteration(const int n, K* const A, const int nu, const underlying_type<K> tol, K* const ev, underlying_type<K>* const evr) {
+            const int p = std::min(n, std::max(2 * nu, nu + 8));
+            if(nu <= 0 || 2 * p > n)
+                return false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+            for(int j = 1; j < n; ++j)
+                for(int i = 0; i < j; ++i)
+                    A[i + j * n] = Wrapper<K>::conj(A[j + i * n]);
+            int lwork = -1, info;
+            {
+                K wkopt[4];
+                Lapack<K>::geqrf(&n, &p, nullptr, &n, nullptr, wkopt, &lwork, &info);
+                Lapack<K>::mqr("L", "N", &n, &p, &p, nullptr, &n, nullptr, nullptr, &n, wkopt + 1, &lwork, &info);
+                Lapack<K>::trd("L", &p, nullptr, &p, nullptr, nullptr, nullptr, wkopt + 2, &lwork, &info);
+                Lapack<K>::mtr("L", "L", "N", &p, &p, nullptr, &p, nullptr, nullptr, &p, wkopt + 3, &lwork, &info);
+                lwork = std::max(std::max(std::real(wkopt[0]), std::real(wkopt[1])), std::max(std::real(wkopt[2]), std::real(wkopt[3])));
+            }
+            K* X = new K[3 * n * p + 2 * p * p + p + lwork];
+            K* Y = X + n * p;
+            K* Z = Y + n * p;
+            K* const H = Z + n * p;
+            K* const W = H + p * p;
+            K* const tau = W + p * p;
+            K* const work = tau + p;
+            K* const base = X;
+            underlying_type<K>* const d = new underlying_type<K>[8 * p];
+            underlying_type<K>* const e = d + p;
+            underlying_type<K>* const theta = e + p;
+            underlying_type<K>* const rwork = theta + p;
+            int* const iblock = new int[6 * p];
+            int* const isplit = iblock + p;
+            int* const ifail = isplit + p;
+            int* const iwork = ifail + p;
+            {
+                std::mt19937 gen;
+                std::uniform_real_distribution<underlying_type<K>> dis(-1.0, 1.0);
+                std::generate_n(X, n * p, [&]() { return K(dis(gen)); });
+            }
+            underlying_type<K> b;
+            {
+                const int k = std::min(p, 20);
+                K* previous = Z;
+                K* v = Z + n;
+                std::fill_n(previous, n, K());
+                std::copy_n(X, n, v);
+                underlying_type<K> beta = Blas<K>::nrm2(&n, v, &i__1);
+                for(int j = 0; j < k; ++j) {
+                    const K scal = 1.0 / beta;
+                    Blas<K>::scal(&n, &scal, v, &i__1);
+                    Blas<K>::gemv("N", &n, &n, &(Wrapper<K>::d__1), A, &n, v, &i__1, &(Wrapper<K>::d__0), Y, &i__1);
+                    d[j] = std::real(Blas<K>::dot(&n, v, &i__1, Y, &i__1));
+                    K alpha = -d[j];
+                    Blas<K>::axpy(&n, &alpha, v, &i__1, Y, &i__1);
+                    alpha = -beta;
+                    Blas<K>::axpy(&n, &alpha, previous, &i__1, Y, &i__1);
+                    e[j] = beta = Blas<K>::nrm2(&n, Y, &i__1);
+                    std::swap(v, previous);
+                    std::copy_n(Y, n, v);
+                }
+                int m, nsplit;
+                const underlying_type<K> abstol = 0.0;
+                Lapack<K>::stebz("I", "E", &k, &abstol, &abstol, &k, &k, &abstol, d, e, &m, &nsplit, theta, iblock, isplit, rwork, iwork, &info);
+                b = theta[0] + beta;
+            }
+#ifdef _OPENMP
+            const int panel = (p + omp_get_max_threads() - 1) / omp_get_max_threads();
+#else
+            const int panel = p;
+#endif
+            const auto multiply = [&](const K* const in, K* const out) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+                for(int j = 0; j < p; j += panel) {
+                    const int k = std::min(panel, p - j);
+                    Blas<K>::gemm("N", "N", &n, &k, &n, &(Wrapper<K>::d__1), A, &n, in + j * n, &n, &(Wrapper<K>::d__0), out + j * n, &n);
+                }
+            };
+            const auto orthonormalize = [&]() {
+                Lapack<K>::geqrf(&n, &p, X, &n, tau, work, &lwork, &info);
+                std::fill_n(Z, n * p, K());
+                for(int j = 0; j < p; ++j)
+                    Z[j * (n + 1)] = Wrapper<K>::d__1;
+                Lapack<K>::mqr("L", "N", &n, &p, &p, X, &n, tau, Z, &n, work, &lwork, &info);
+                std::swap(X, Z);
+            };
+            const auto rayleighRitz = [&]() {
+                multiply(X, Y);
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &p, &p, &n, &(Wrapper<K>::d__1), X, &n, Y, &n, &(Wrapper<K>::d__0), H, &p);
+                Lapack<K>::trd("L", &p, H, &p, d, e, tau, work, &lwork, &info);
+                const underlying_type<K> abstol = 0.0;
+                int m, nsplit;
+                Lapack<K>::stebz("A", "B", &p, &abstol, &abstol, &i__1, &p, &abstol, d, e, &m, &nsplit, theta, iblock, isplit, rwork, iwork, &info);
+                if(info || m != p)
+                    return false;
+                Lapack<K>::stein(&p, d, e, &m, theta, iblock, isplit, W, &p, rwork, iwork, ifail, &info);
+                Lapack<K>::mtr("L", "L", "N", &p, &p, H, &p, tau, W, &p, work, &lwork, &info);
+                std::vector<int> order(p);
+                std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [&](int lhs, int rhs) { return theta[lhs] < theta[rhs]; });
+                for(int j = 0; j < p; ++j) {
+                    std::copy_n(W + order[j] * p, p, H + j * p);
+                    d[j] = theta[order[j]];
+                }
+                std::copy_n(d, p, theta);
+                Blas<K>::gemm("N", "N", &n, &p, &p, &(Wrapper<K>::d__1), X, &n, H, &p, &(Wrapper<K>::d__0), Z, &n);
+                std::swap(X, Z);
+                Blas<K>::gemm("N", "N", &n, &p, &p, &(Wrapper<K>::d__1), Y, &n, H, &p, &(Wrapper<K>::d__0), Z, &n);
+                std::swap(Y, Z);
+                underlying_type<K> residual = 0.0;
+                for(int j = 0; j < nu; ++j) {
+                    const K alpha = -theta[j];
+                    std::copy_n(Y + j * n, n, Z);
+                    Blas<K>::axpy(&n, &alpha, X + j * n, &i__1, Z, &i__1);
+                    residual = std::max(residual, Blas<K>::nrm2(&n, Z, &i__1));
+                }
+                return residual <= tol * b;
+            };
+            const auto filter = [&](const unsigned short degree) {
+                const underlying_type<K> radius = (b - theta[p - 1]) / 2.0, center = (b + theta[p - 1]) / 2.0;
+                underlying_type<K> sigma = radius / (theta[0] - center);
+                const underlying_type<K> scaling = 2.0 / sigma;
+                multiply(X, Y);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
+#endif
+                for(int i = 0; i < n * p; ++i)
+                    Y[i] = (Y[i] - center * X[i]) * (sigma / radius);
+                for(unsigned short k = 1; k < degree; ++k) {
+                    const underlying_type<K> next = 1.0 / (scaling - sigma);
+                    multiply(Y, Z);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
+#endif
+                    for(int i = 0; i < n * p; ++i)
+                        Z[i] = (Z[i] - center * Y[i]) * (2.0 * next / radius) - (sigma * next) * X[i];
+                    std::swap(X, Y);
+                    std::swap(Y, Z);
+                    sigma = next;
+                }
+                std::swap(X, Y);
+            };
+            orthonormalize();
+            bool converged = rayleighRitz();
+            for(unsigned short it = 0; it < 50 && !converged && info == 0 && theta[p - 1] < b; ++it) {
+                filter(10);
+                orthonormalize();
+                converged = rayleighRitz();
+            }
+            if(converged) {
+                std::copy_n(X, n * nu, ev);
+                std::copy_n(theta, nu, evr);
+            }
+            delete [] iblock;
+            delete [] d;
+            delete [] base;
+            return converged;
+        }
+        /* Function: schurEntry
+         *
+         *  Returns a coefficient of the lower triangular part of <Schur::schur>, whether it is stored in dense or block low-rank format.
+         *
+         * Parameters:
+         *    i              - Row index.
+         *    j              - Column index, lower than or equal to i. */
+        K schurEntry(const int i, const int j) const {
+            if(_tiles.empty())
+                return _schur[i + j * Subdomain<K>::_dof];
+            const int I = i / HPDDM_BLR_TILE, J = j / HPDDM_BLR_TILE;
+            const int rows = std::min(HPDDM_BLR_TILE, Subdomain<K>::_dof - I * HPDDM_BLR_TILE);
+            const std::pair<unsigned int, int>& tile = _tiles[(I * (I + 1)) / 2 + J];
+            const K* const a = _schur + tile.first;
+            if(tile.second < 0)
+                return a[i - I * HPDDM_BLR_TILE + (j - J * HPDDM_BLR_TILE) * rows];
+            K entry = K();
+            for(int k = 0; k < tile.second; ++k)
+                entry += a[i - I * HPDDM_BLR_TILE + k * rows] * a[rows * tile.second + k + (j - J * HPDDM_BLR_TILE) * tile.second];
+            return entry;
+        }
+        /* Function: compressSchurComplement
+         *
+         *  Stores <Schur::schur> in block low-rank format. Diagonal tiles remain dense, while off-diagonal tiles are replaced by truncated singular value decompositions whenever this saves memory.
+         *
+         * Parameter:
+         *    tol            - Threshold on the singular values relative to the Frobenius norm of <Schur::schur>. */
+        void compressSchurComplement(const underlying_type<K>& tol) {
+            const int n = Subdomain<K>::_dof;
+            const int nb = (n + HPDDM_BLR_TILE - 1) / HPDDM_BLR_TILE;
+            const underlying_type<K> threshold = tol * Lapack<K>::lan("F", "L", &n, _schur, &n, nullptr);
+            std::vector<std::vector<K>> tmp((nb * (nb + 1)) / 2);
+            _tiles.resize(tmp.size());
+            int lwork = -1;
+            {
+                const int tile = HPDDM_BLR_TILE;
+                K wkopt;
+                int info;
+                Lapack<K>::gesdd("S", &tile, &tile, nullptr, &tile, nullptr, nullptr, &tile, nullptr, &tile, &wkopt, &lwork, nullptr, nullptr, &info);
+                lwork = std::real(wkopt);
+            }
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                K* const work = new K[(3 * HPDDM_BLR_TILE + 1) * HPDDM_BLR_TILE + lwork];
+                K* const u = work + HPDDM_BLR_TILE * HPDDM_BLR_TILE;
+                K* const vt = u + HPDDM_BLR_TILE * HPDDM_BLR_TILE;
+                K* const wk = vt + HPDDM_BLR_TILE * HPDDM_BLR_TILE;
+                underlying_type<K>* const sigma = new underlying_type<K>[HPDDM_BLR_TILE + (Wrapper<K>::is_complex ? HPDDM_BLR_TILE * (5 * HPDDM_BLR_TILE + 7) : 0)];
+                int* const iwork = new int[8 * HPDDM_BLR_TILE];
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+                for(int t = 0; t < static_cast<int>(tmp.size()); ++t) {
+                    int I = 0;
+                    while(((I + 1) * (I + 2)) / 2 <= t)
+                        ++I;
+                    const int J = t - (I * (I + 1)) / 2;
+                    const int rows = std::min(HPDDM_BLR_TILE, n - I * HPDDM_BLR_TILE);
+                    const int cols = std::min(HPDDM_BLR_TILE, n - J * HPDDM_BLR_TILE);
+                    const K* const a = _schur + I * HPDDM_BLR_TILE + J * HPDDM_BLR_TILE * n;
+                    _tiles[t].second = -1;
+                    if(I != J) {
+                        const int k = std::min(rows, cols);
+                        int info;
+                        Blas<K>::lacpy("A", &rows, &cols, a, &n, work, &rows);
+                        Lapack<K>::gesdd("S", &rows, &cols, work, &rows, sigma, u, &rows, vt, &k, wk, &lwork, sigma + HPDDM_BLR_TILE, iwork, &info);
+                        const int r = std::distance(sigma, std::find_if(sigma, sigma + k, [&](const underlying_type<K>& v) { return v <= threshold; }));
+                        if(!info && r * (rows + cols) < rows * cols) {
+                            tmp[t].resize(r * (rows + cols));
+                            std::copy_n(u, r * rows, tmp[t].begin());
+                            for(int j = 0; j < cols; ++j)
+                                for(int i = 0; i < r; ++i)
+                                    tmp[t][r * rows + i + j * r] = sigma[i] * vt[i + j * k];
+                            _tiles[t].second = r;
+                            continue;
                         }
                     }
-                else
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        int index;
-                        MPI_Waitany(Subdomain<K>::_map.size(), Subdomain<K>::_rq, &index, MPI_STATUS_IGNORE);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[index].second.size(); ++j)
-                            for(unsigned int k = 0; k < Subdomain<K>::_map[index].second.size(); ++k)
-                                if(Subdomain<K>::_map[index].second[j] <= Subdomain<K>::_map[index].second[k])
-                                    res[Subdomain<K>::_map[index].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[index].second[k]] += recv[index][j * Subdomain<K>::_map[index].second.size() + k];
+                    tmp[t].resize(rows * cols);
+                    Blas<K>::lacpy(I != J ? "A" : "L", &rows, &cols, a, &n, tmp[t].data(), &rows);
+                }
+                delete [] iwork;
+                delete [] sigma;
+                delete [] work;
+            }
+            unsigned int size = 0;
+            for(unsigned int t = 0; t < tmp.size(); ++t) {
+                _tiles[t].first = size;
+                size += tmp[t].size();
+            }
+            delete [] _schur;
+            _schur = new K[size];
+            for(unsigned int t = 0; t < tmp.size(); ++t)
+                std::copy(tmp[t].cbegin(), tmp[t].cend(), _schur + _tiles[t].first);
+        }
+        /* Function: applyCompressedSchurComplement
+         *
+         *  Applies <Schur::schur> stored in block low-rank format to multiple right-hand sides.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    n              - Number of vectors. */
+        void applyCompressedSchurComplement(const K* const in, K* const out, const int& n) const {
+            const int nb = (Subdomain<K>::_dof + HPDDM_BLR_TILE - 1) / HPDDM_BLR_TILE;
+            K* const tmp = new K[HPDDM_BLR_TILE * n];
+            std::fill_n(out, Subdomain<K>::_dof * n, K());
+            for(int I = 0; I < nb; ++I) {
+                const int rows = std::min(HPDDM_BLR_TILE, Subdomain<K>::_dof - I * HPDDM_BLR_TILE);
+                for(int J = 0; J <= I; ++J) {
+                    const int cols = std::min(HPDDM_BLR_TILE, Subdomain<K>::_dof - J * HPDDM_BLR_TILE);
+                    const std::pair<unsigned int, int>& tile = _tiles[(I * (I + 1)) / 2 + J];
+                    const K* const a = _schur + tile.first;
+                    if(I == J)
+                        Blas<K>::symm("L", "L", &rows, &n, &(Wrapper<K>::d__1), a, &rows, in + I * HPDDM_BLR_TILE, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), out + I * HPDDM_BLR_TILE, &(Subdomain<K>::_dof));
+                    else if(tile.second < 0) {
+                        Blas<K>::gemm("N", "N", &rows, &n, &cols, &(Wrapper<K>::d__1), a, &rows, in + J * HPDDM_BLR_TILE, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), out + I * HPDDM_BLR_TILE, &(Subdomain<K>::_dof));
+                        Blas<K>::gemm("T", "N", &cols, &n, &rows, &(Wrapper<K>::d__1), a, &rows, in + I * HPDDM_BLR_TILE, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), out + J * HPDDM_BLR_TILE, &(Subdomain<K>::_dof));
+                    }
+                    else if(tile.second) {
+                        const K* const w = a + rows * tile.second;
+                        Blas<K>::gemm("N", "N", &(tile.second), &n, &cols, &(Wrapper<K>::d__1), w, &(tile.second), in + J * HPDDM_BLR_TILE, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), tmp, &(tile.second));
+                        Blas<K>::gemm("N", "N", &rows, &n, &(tile.second), &(Wrapper<K>::d__1), a, &rows, tmp, &(tile.second), &(Wrapper<K>::d__1), out + I * HPDDM_BLR_TILE, &(Subdomain<K>::_dof));
+                        Blas<K>::gemm("T", "N", &(tile.second), &n, &rows, &(Wrapper<K>::d__1), a, &rows, in + I * HPDDM_BLR_TILE, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), tmp, &(tile.second));
+                        Blas<K>::gemm("T", "N", &cols, &n, &(tile.second), &(Wrapper<K>::d__1), w, &(tile.second), tmp, &(tile.second), &(Wrapper<K>::d__1), out + J * HPDDM_BLR_TILE, &(Subdomain<K>::_dof));
+                    }
+                }
+            }
+            delete [] tmp;
+        }
+        /* Function: permute
+         *
+         *  Gathers or scatters vectors with <Schur::permutation>.
+         *
+         * Template Parameter:
+         *    forward        - True to go from the numbering of the user to the internal numbering, false otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    mu             - Number of vectors. */
+        template<bool forward>
+        void permute(K* const in, const unsigned short& mu) const {
+            if(!_permutation.empty()) {
+                const int n = _permutation.size();
+                K* const tmp = new K[n];
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    K* const x = in + nu * n;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
+#endif
+                    for(int i = 0; i < n; ++i) {
+                        if(forward)
+                            tmp[i] = x[_permutation[i]];
+                        else
+                            tmp[_permutation[i]] = x[i];
                     }
+                    std::copy_n(tmp, n, x);
+                }
+                delete [] tmp;
             }
         }
+        /* Function: splitLocalSubdomain
+         *
+         *  Splits <Subdomain::a> into independent local subdomains, cf. <Schur::blocks>. An unknown coupled to an unknown of a local subdomain with a lower index becomes a separator, and separators are appended to the interface so that they are assembled in <Schur::schur> without any message. <Subdomain::map> is renumbered accordingly.
+         *
+         * Parameters:
+         *    interface      - Numbering of the interface.
+         *    part           - Local subdomain of each unknown.
+         *
+         * Returns: The numbering of the interface including the separators. */
+        template<class Container>
+        std::vector<int> splitLocalSubdomain(const Container& interface, const std::vector<unsigned short>& part) {
+            const MatrixCSR<K>* const A = Subdomain<K>::_a;
+            std::vector<char> type(A->_n);
+            for(unsigned int i = 0; i < interface.size(); ++i)
+                type[interface[i]] = 1;
+            for(int i = 0; i < A->_n; ++i)
+                for(int j = A->_ia[i]; j < A->_ia[i + 1] && !type[i]; ++j) {
+                    const int k = A->_ja[j];
+                    if(!type[k] && part[k] != part[i])
+                        type[part[k] > part[i] ? k : i] = 2;
+                }
+            std::vector<int> separated;
+            std::vector<int> position;
+            separated.reserve(interface.size());
+            position.reserve(interface.size());
+            _blocks.resize(*std::max_element(part.cbegin(), part.cend()) + 1);
+            for(int i = 0, j = 0; i < A->_n; ++i) {
+                if(type[i] == 1)
+                    position.emplace_back(separated.size());
+                if(type[i])
+                    separated.emplace_back(i);
+                else
+                    _blocks[part[i]].emplace_back(j++);
+            }
+            for(pairNeighbor& neighbor : Subdomain<K>::_map)
+                for(int& i : neighbor.second)
+                    i = position[i];
+            return separated;
+        }
     protected:
         /* Variable: bb
          *  Local matrix assembled on boundary degrees of freedom. */
@@ -115,6 +502,12 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Variable: schur
          *  Explicit local Schur complement. */
         K*                  _schur;
+        /* Variable: tiles
+         *  Offsets and ranks (negative for dense tiles) of the tiles of <Schur::schur> when it is stored in block low-rank format, empty otherwise. */
+        std::vector<std::pair<unsigned int, int>> _tiles;
+        /* Variable: permutation
+         *  Indices in the numbering of the user of the unknowns renumbered by <Schur::renumber>, empty if both numberings are the same. */
+        std::vector<int>  _permutation;
         /* Variable: work
          *  Workspace array. */
         K*                   _work;
@@ -136,6 +529,151 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Variable: deficiency
          *  Dimension of the kernel of <Subdomain::a>. */
         unsigned short _deficiency;
+        /* Variable: fixed
+         *  Interface unknowns regularized when factorizing <Subdomain::a> or <Schur::schur> of floating subdomains, cf. <Schur::computeKernel>. */
+        std::vector<int>      _fixed;
+        /* Variable: detected
+         *  True if <Schur::computeKernel> has already been called, false otherwise. */
+        bool               _detected;
+        /* Variable: elapsed
+         *  Time spent in the last call to <Schur::callNumfact>. */
+        double              _elapsed;
+        /* Variable: partition
+         *  Local subdomain of each unknown of <Subdomain::a>, cf. <Schur::setLocalPartition>, cleared by <Schur::renumber>. */
+        std::vector<unsigned short> _partition;
+        /* Variable: blocks
+         *  Interior unknowns of each local subdomain when <Subdomain::a> is split by <Schur::renumber>, empty otherwise. */
+        std::vector<std::vector<int>> _blocks;
+        /* Variable: local
+         *  Diagonal blocks of <Schur::ii> and their factorizations, one per local subdomain of <Schur::blocks>. */
+        std::vector<std::pair<MatrixCSR<K>*, Solver<K>*>> _local;
+        /* Function: regularize
+         *
+         *  Adds or removes a penalty on the diagonal entries of <Subdomain::a> associated to <Schur::fixed>.
+         *
+         * Parameter:
+         *    penalty        - Value to add. */
+        void regularize(const underlying_type<K>& penalty) {
+            for(const int& i : _fixed) {
+                const int row = _bi->_m + i;
+                const int* const diagonal = std::find(Subdomain<K>::_a->_ja + Subdomain<K>::_a->_ia[row], Subdomain<K>::_a->_ja + Subdomain<K>::_a->_ia[row + 1], row);
+                Subdomain<K>::_a->_a[std::distance(static_cast<const int*>(Subdomain<K>::_a->_ja), diagonal)] += penalty;
+            }
+        }
+        /* Function: factorizeInterior
+         *
+         *  Factorizes <Schur::ii>, or each of its diagonal blocks <Schur::local> concurrently if <Subdomain::a> is split into local subdomains. The solver of the local subdomains must then be thread-safe. */
+        void factorizeInterior() {
+            if(_blocks.empty())
+                super::_s.numfact(_ii);
+            else {
+                if(_local.empty()) {
+                    std::vector<int> local(_ii->_n);
+                    _local.reserve(_blocks.size());
+                    for(const std::vector<int>& block : _blocks) {
+                        int nnz = 0;
+                        for(unsigned int i = 0; i < block.size(); ++i) {
+                            local[block[i]] = i;
+                            nnz += _ii->_ia[block[i] + 1] - _ii->_ia[block[i]];
+                        }
+                        MatrixCSR<K>* const A = new MatrixCSR<K>(block.size(), block.size(), nnz, _ii->_sym);
+                        A->_ia[0] = 0;
+                        for(unsigned int i = 0; i < block.size(); ++i) {
+                            for(int j = _ii->_ia[block[i]]; j < _ii->_ia[block[i] + 1]; ++j)
+                                A->_ja[A->_ia[i] + j - _ii->_ia[block[i]]] = local[_ii->_ja[j]];
+                            A->_ia[i + 1] = A->_ia[i] + _ii->_ia[block[i] + 1] - _ii->_ia[block[i]];
+                        }
+                        _local.emplace_back(A, nullptr);
+                    }
+                }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for(int i = 0; i < static_cast<int>(_local.size()); ++i) {
+                    MatrixCSR<K>* const A = _local[i].first;
+                    for(int j = 0; j < A->_n; ++j)
+                        std::copy(_ii->_a + _ii->_ia[_blocks[i][j]], _ii->_a + _ii->_ia[_blocks[i][j] + 1], A->_a + A->_ia[j]);
+                    delete _local[i].second;
+                    _local[i].second = new Solver<K>();
+                    _local[i].second->numfact(A);
+                }
+            }
+        }
+        /* Function: solveInterior
+         *
+         *  Solves systems with <Schur::ii>, one local subdomain per thread if <Subdomain::a> is split into local subdomains.
+         *
+         * Parameters:
+         *    x              - Input right-hand sides, solution vectors on output.
+         *    n              - Number of right-hand sides. */
+        void solveInterior(K* const x, const unsigned short& n = 1) const {
+            if(_local.empty()) {
+                if(n == 1)
+                    super::_s.solve(x);
+                else
+                    super::_s.solve(x, n);
+            }
+            else {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for(int i = 0; i < static_cast<int>(_local.size()); ++i) {
+                    const std::vector<int>& block = _blocks[i];
+                    K* const y = new K[n * block.size()];
+                    for(unsigned short nu = 0; nu < n; ++nu)
+                        for(unsigned int j = 0; j < block.size(); ++j)
+                            y[nu * block.size() + j] = x[nu * _bi->_m + block[j]];
+                    _local[i].second->solve(y, n);
+                    for(unsigned short nu = 0; nu < n; ++nu)
+                        for(unsigned int j = 0; j < block.size(); ++j)
+                            x[nu * _bi->_m + block[j]] = y[nu * block.size() + j];
+                    delete [] y;
+                }
+            }
+        }
+        /* Function: solveInterior
+         *
+         *  Solves a system with <Schur::ii> without overwriting the right-hand side.
+         *
+         * Parameters:
+         *    b              - Input right-hand side.
+         *    x              - Solution vector. */
+        void solveInterior(const K* const b, K* const x) const {
+            if(_local.empty())
+                super::_s.solve(b, x);
+            else {
+                std::copy_n(b, _bi->_m, x);
+                solveInterior(x);
+            }
+        }
+        /* Function: expandSchurComplement
+         *
+         *  Copies the lower triangular part of <Schur::schur> into a dense matrix, whether it is stored in dense or block low-rank format.
+         *
+         * Parameter:
+         *    A              - Output matrix. */
+        void expandSchurComplement(K* const A) const {
+            if(_tiles.empty())
+                Blas<K>::lacpy("L", &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), _schur, &(Subdomain<K>::_dof), A, &(Subdomain<K>::_dof));
+            else {
+                const int nb = (Subdomain<K>::_dof + HPDDM_BLR_TILE - 1) / HPDDM_BLR_TILE;
+                for(int I = 0; I < nb; ++I) {
+                    const int rows = std::min(HPDDM_BLR_TILE, Subdomain<K>::_dof - I * HPDDM_BLR_TILE);
+                    for(int J = 0; J <= I; ++J) {
+                        const int cols = std::min(HPDDM_BLR_TILE, Subdomain<K>::_dof - J * HPDDM_BLR_TILE);
+                        const std::pair<unsigned int, int>& tile = _tiles[(I * (I + 1)) / 2 + J];
+                        K* const b = A + I * HPDDM_BLR_TILE + J * HPDDM_BLR_TILE * Subdomain<K>::_dof;
+                        if(tile.second < 0)
+                            Blas<K>::lacpy(I != J ? "A" : "L", &rows, &cols, _schur + tile.first, &rows, b, &(Subdomain<K>::_dof));
+                        else if(tile.second)
+                            Blas<K>::gemm("N", "N", &rows, &cols, &(tile.second), &(Wrapper<K>::d__1), _schur + tile.first, &rows, _schur + tile.first + rows * tile.second, &(tile.second), &(Wrapper<K>::d__0), b, &(Subdomain<K>::_dof));
+                        else
+                            for(int j = 0; j < cols; ++j)
+                                std::fill_n(b + j * Subdomain<K>::_dof, rows, K());
+                    }
+                }
+            }
+        }
         /* Function: solveGEVP
          *
          *  Solves the GenEO problem.
@@ -166,44 +704,77 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                         recv[i] = recv[i - 1] + Subdomain<K>::_map[i - 1].second.size() * Subdomain<K>::_map[i - 1].second.size();
                     }
                 K* res = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
-                exchangeSchurComplement<L>(send, recv, res);
-
-                Eigensolver<K> evp(nu >= 10 ? (nu >= 40 ? 1.0e-14 : 1.0e-12) : 1.0e-8, threshold, Subdomain<K>::_dof, nu);
                 K* A;
                 if(size < Subdomain<K>::_dof * Subdomain<K>::_dof)
                     A = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
                 else
                     A = *recv;
-                Blas<K>::lacpy("L", &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), _schur, &(Subdomain<K>::_dof), A, &(Subdomain<K>::_dof));
-                if(d)
+                std::vector<MPI_Request> rq;
+                if(Option::get()->val<char>(super::prefix("geneo_transfer"), 0) == 1)
+                    exchangeSchurComplement<L, typename std::conditional<std::is_same<underlying_type<K>, K>::value, float, std::complex<float>>::type>(send, recv, res, A != *recv ? A : nullptr, rq);
+                else
+                    exchangeSchurComplement<L, K>(send, recv, res, A != *recv ? A : nullptr, rq);
+
+                Eigensolver<K> evp(nu >= 10 ? (nu >= 40 ? 1.0e-14 : 1.0e-12) : 1.0e-8, threshold, Subdomain<K>::_dof, nu);
+                if(A == *recv)
+                    expandSchurComplement(A);
+                if(d) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
                     for(unsigned int i = 0; i < Subdomain<K>::_dof; ++i)
                         for(unsigned int j = i; j < Subdomain<K>::_dof; ++j)
                             res[j + i * Subdomain<K>::_dof] *= d[i] * d[j];
+                }
                 int flag, info;
                 Lapack<K>::potrf("L", &(Subdomain<K>::_dof), res, &(Subdomain<K>::_dof), &flag);
                 Lapack<K>::gst(&i__1, "L", &(Subdomain<K>::_dof), A, &(Subdomain<K>::_dof), res, &(Subdomain<K>::_dof), &flag);
+                const auto allocate = [&](const int n) {
+                    if(super::_ev) {
+                        if(*super::_ev)
+                            delete [] *super::_ev;
+                        delete [] super::_ev;
+                    }
+                    super::_ev = new K*[n];
+                    *super::_ev = new K[Subdomain<K>::_dof * n];
+                    for(unsigned short i = 1; i < n; ++i)
+                        super::_ev[i] = *super::_ev + i * Subdomain<K>::_dof;
+                };
+                underlying_type<K>* evr = nullptr;
+                if(Option::get()->val<char>(super::prefix("geneo_dense_solver"), 0) == 1) {
+                    evr = new underlying_type<K>[evp._nu];
+                    allocate(evp._nu);
+                    if(subspaceIteration(Subdomain<K>::_dof, A, evp._nu, std::max(evp.getTol(), static_cast<underlying_type<K>>(std::sqrt(Subdomain<K>::_dof) * 10 * std::numeric_limits<underlying_type<K>>::epsilon())), *super::_ev, evr)) {
+                        if(threshold > 0.0)
+                            evp._nu = std::distance(evr, std::upper_bound(evr, evr + evp._nu, threshold));
+                    }
+                    else {
+                        delete [] evr;
+                        evr = nullptr;
+                    }
+                }
                 int lwork = -1;
-                {
+                if(!evr) {
                     K wkopt;
                     Lapack<K>::trd("L", &(Subdomain<K>::_dof), nullptr, &(Subdomain<K>::_dof), nullptr, nullptr, nullptr, &wkopt, &lwork, &info);
                     lwork = std::real(wkopt);
                 }
-                MPI_Testall(Subdomain<K>::_map.size(), Subdomain<K>::_rq + Subdomain<K>::_map.size(), &flag, MPI_STATUSES_IGNORE);
-                K* work;
-                const int storage = !Wrapper<K>::is_complex ? 4 * Subdomain<K>::_dof - 1 : 2 * Subdomain<K>::_dof;
-                if(flag) {
-                    if((lwork + storage) <= size || (A != *recv && (lwork + storage) <= 2 * size))
-                        work = *send;
-                    else
-                        work = new K[lwork + storage];
-                }
-                else {
-                    if(A != *recv && (lwork + storage) <= size)
-                        work = *recv;
-                    else
-                        work = new K[lwork + storage];
-                }
-                {
+                MPI_Testall(rq.size() / 2, rq.data() + rq.size() / 2, &flag, MPI_STATUSES_IGNORE);
+                K* work = nullptr;
+                const int storage = !Wrapper<K>::is_complex ? 4 * Subdomain<K>::_dof - 1 : Subdomain<K>::_dof + (3 * Subdomain<K>::_dof + 1) / 2;
+                if(!evr) {
+                    if(flag) {
+                        if((lwork + storage) <= size || (A != *recv && (lwork + storage) <= 2 * size))
+                            work = *send;
+                        else
+                            work = new K[lwork + storage];
+                    }
+                    else {
+                        if(A != *recv && (lwork + storage) <= size)
+                            work = *recv;
+                        else
+                            work = new K[lwork + storage];
+                    }
                     K* tau = work + lwork;
                     underlying_type<K>* d = reinterpret_cast<underlying_type<K>*>(tau + Subdomain<K>::_dof);
                     underlying_type<K>* e = d + Subdomain<K>::_dof;
@@ -212,7 +783,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     underlying_type<K> vu = threshold;
                     int iu = evp._nu;
                     int nsplit;
-                    underlying_type<K>* evr = e + Subdomain<K>::_dof - 1;
+                    evr = e + Subdomain<K>::_dof - 1;
                     int* iblock = new int[5 * Subdomain<K>::_dof];
                     int* isplit = iblock + Subdomain<K>::_dof;
                     int* iwork = isplit + Subdomain<K>::_dof;
@@ -220,35 +791,24 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     underlying_type<K> tol = evp.getTol();
                     Lapack<K>::stebz(&range, "B", &(Subdomain<K>::_dof), &vl, &vu, &i__1, &iu, &tol, d, e, &evp._nu, &nsplit, evr, iblock, isplit, reinterpret_cast<underlying_type<K>*>(work), iwork, &info);
                     if(evp._nu) {
-                        if(super::_ev) {
-                            if(*super::_ev)
-                                delete [] *super::_ev;
-                            delete [] super::_ev;
-                        }
-                        super::_ev = new K*[evp._nu];
-                        *super::_ev = new K[Subdomain<K>::_dof * evp._nu];
-                        for(unsigned short i = 1; i < evp._nu; ++i)
-                            super::_ev[i] = *super::_ev + i * Subdomain<K>::_dof;
+                        allocate(evp._nu);
                         int* ifailv = new int[evp._nu];
                         Lapack<K>::stein(&(Subdomain<K>::_dof), d, e, &(evp._nu), evr, iblock, isplit, *super::_ev, &(Subdomain<K>::_dof), reinterpret_cast<underlying_type<K>*>(work), iwork, ifailv, &info);
                         delete [] ifailv;
                         Lapack<K>::mtr("L", "L", "N", &(Subdomain<K>::_dof), &(evp._nu), A, &(Subdomain<K>::_dof), tau, *super::_ev, &(Subdomain<K>::_dof), work, &lwork, &info);
-                        if(!Wrapper<K>::is_complex)
-                            lwork += 3 * Subdomain<K>::_dof - 1;
-                        else
-                            lwork += 4 * Subdomain<K>::_dof - 1;
                     }
                     delete [] iblock;
                 }
-                (*Option::get())["geneo_nu"] = nu = evp._nu;
+                Option::get()->set(super::prefix("geneo_nu"), nu = evp._nu);
                 if(super::_co)
                     super::_co->setLocal(nu);
-                if(nu && *(reinterpret_cast<underlying_type<K>*>(work) + lwork) < 2 * evp.getTol()) {
+                if(nu && evr[0] < 2 * evp.getTol()) {
                     _deficiency = 1;
-                    underlying_type<K> relative = *(reinterpret_cast<underlying_type<K>*>(work) + lwork);
-                    while(_deficiency < nu && std::abs(*(reinterpret_cast<underlying_type<K>*>(work) + lwork + _deficiency) / relative) * std::cbrt(evp.getTol()) < 1)
+                    while(_deficiency < nu && std::abs(evr[_deficiency] / evr[0]) * std::cbrt(evp.getTol()) < 1)
                         ++_deficiency;
                 }
+                if(!work)
+                    delete [] evr;
                 if(A != *recv)
                     delete [] A;
                 if(nu)
@@ -261,7 +821,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                 if(work != *recv && work != *send)
                     delete [] work;
                 if(!flag)
-                    MPI_Waitall(Subdomain<K>::_map.size(), Subdomain<K>::_rq + Subdomain<K>::_map.size(), MPI_STATUSES_IGNORE);
+                    MPI_Waitall(rq.size() / 2, rq.data() + rq.size() / 2, MPI_STATUSES_IGNORE);
                 delete [] res;
                 delete [] *send;
             }
@@ -270,7 +830,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         }
         template<unsigned short excluded, class Operator, class Prcndtnr>
         std::pair<MPI_Request, const K*>* buildTwo(Prcndtnr* B, const MPI_Comm& comm) {
-            if(!Option::get()->set("geneo_nu")) {
+            if(!Option::get()->set(super::prefix("geneo_nu"))) {
                 if(!super::_co)
                     super::_co = new typename std::remove_reference<decltype(*super::_co)>::type;
                 super::_co->setLocal(_deficiency);
@@ -278,7 +838,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             return super::template buildTwo<excluded, Operator>(B, comm);
         }
     public:
-        Schur() : _bb(), _ii(), _bi(), _schur(), _work(), _structure(), _pinv(), _mult(), _signed(), _deficiency() { }
+        Schur() : _bb(), _ii(), _bi(), _schur(), _tiles(), _work(), _structure(), _pinv(), _mult(), _signed(), _deficiency(), _detected(false), _elapsed(), _partition(), _blocks(), _local() { }
         Schur(const Schur&) = delete;
         ~Schur() {
             delete _bb;
@@ -286,10 +846,14 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             delete _ii;
             if(!HPDDM_QR || !_schur)
                 delete static_cast<Solver<K>*>(_pinv);
-            else if(_deficiency)
+            else if(_deficiency && _fixed.empty())
                 delete static_cast<QR<K>*>(_pinv);
             else
                 delete [] static_cast<K*>(_pinv);
+            for(const std::pair<MatrixCSR<K>*, Solver<K>*>& p : _local) {
+                delete p.first;
+                delete p.second;
+            }
             delete [] _schur;
             delete [] _work;
         }
@@ -318,10 +882,18 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Function: callNumfact
          *  Factorizes <Subdomain::a>. */
         void callNumfact() {
+            if(_schur && Option::get()->set(super::prefix("substructuring_kernel_tol")))
+                computeKernel();
             if(Subdomain<K>::_a) {
+                _elapsed = MPI_Wtime();
                 _pinv = new Solver<K>();
                 Solver<K>* p = static_cast<Solver<K>*>(_pinv);
-                if(_deficiency) {
+                if(_deficiency && !_fixed.empty()) {
+                    regularize(HPDDM_PEN);
+                    p->numfact(Subdomain<K>::_a);
+                    regularize(-HPDDM_PEN);
+                }
+                else if(_deficiency) {
 #if defined(MUMPSSUB) || defined(PASTIXSUB)
                     p->numfact(Subdomain<K>::_a, true);
 #else
@@ -334,6 +906,8 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                 }
                 else
                     p->numfact(Subdomain<K>::_a);
+                _elapsed = MPI_Wtime() - _elapsed;
+                super::refreshed(0, _elapsed);
             }
             else
                 std::cerr << "The matrix '_a' has not been allocated => impossible to build the Neumann preconditioner" << std::endl;
@@ -347,6 +921,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     delete _ii;
                     _ii = nullptr;
                 }
+                _blocks.clear();
                 if(!_schur) {
                     _schur = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
                     _schur[0] = Subdomain<K>::_dof;
@@ -362,8 +937,109 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             else
                 std::cerr << "The matrix '_a' has not been allocated => impossible to build the Schur complement" << std::endl;
 #else
-#pragma message("Consider changing your linear solver if you need to compute solutions of singular systems or Schur complements")
+#pragma message("Consider changing your linear solver if you need to compute solutions of singular systems")
+            if(_ii && _bi && _bb) {
+                if(!_schur) {
+                    if(_ii->_n)
+                        factorizeInterior();
+                    _schur = new K[Subdomain<K>::_dof * Subdomain<K>::_dof]();
+                    if(_bi->_m) {
+                        std::vector<int> column;
+                        column.reserve(Subdomain<K>::_dof);
+                        for(int j = 0; j < Subdomain<K>::_dof; ++j)
+                            if(_bi->_ia[j + 1] != _bi->_ia[j])
+                                column.emplace_back(j);
+                        const int block = std::min(static_cast<int>(column.size()), 128);
+                        K* const x = new K[block * (_bi->_m + Subdomain<K>::_dof)];
+                        K* const y = x + block * _bi->_m;
+                        for(unsigned int i = 0; i < column.size(); i += block) {
+                            const int n = std::min(static_cast<int>(column.size() - i), block);
+                            std::fill_n(x, n * _bi->_m, K());
+                            for(int j = 0; j < n; ++j)
+                                for(int k = _bi->_ia[column[i + j]] - (Wrapper<K>::I == 'F'); k < _bi->_ia[column[i + j] + 1] - (Wrapper<K>::I == 'F'); ++k)
+                                    x[j * _bi->_m + _bi->_ja[k] - (Wrapper<K>::I == 'F')] = _bi->_a[k];
+                            solveInterior(x, n);
+                            Wrapper<K>::template csrmm<Wrapper<K>::I>("N", &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__2), false, _bi->_a, _bi->_ia, _bi->_ja, x, &_bi->_m, &(Wrapper<K>::d__0), y, &(Subdomain<K>::_dof));
+                            for(int j = 0; j < n; ++j)
+                                std::copy(y + j * Subdomain<K>::_dof + column[i + j], y + (j + 1) * Subdomain<K>::_dof, _schur + column[i + j] * (Subdomain<K>::_dof + 1));
+                        }
+                        delete [] x;
+                    }
+                    for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                        for(int j = _bb->_ia[i] - (Wrapper<K>::I == 'F'); j < _bb->_ia[i + 1] - (Wrapper<K>::I == 'F'); ++j) {
+                            const int k = _bb->_ja[j] - (Wrapper<K>::I == 'F');
+                            _schur[std::max(i, k) + std::min(i, k) * Subdomain<K>::_dof] += _bb->_a[j];
+                        }
+                }
+            }
+            else
+                std::cerr << "The matrices '_ii', '_bi', and '_bb' have not been allocated => impossible to build the Schur complement" << std::endl;
 #endif
+            const underlying_type<K> tol = Option::get()->val(super::prefix("substructuring_compression"), 0.0);
+            if(_schur && _tiles.empty() && tol > 0.0)
+                compressSchurComplement(tol);
+        }
+        /* Function: computeKernel
+         *
+         *  Detects the kernel of <Schur::schur> with a pivoted Cholesky factorization, and selects the interface unknowns regularized by <Schur::callNumfact> and <Bdd::callNumfact>. If kernel vectors have been supplied with <Preconditioner::setVectors> and <Schur::setDeficiency>, only the regularized unknowns are selected. The results are reused by subsequent numerical factorizations with the same sparsity pattern.
+         *
+         * Parameter:
+         *    force          - True to discard a previously detected kernel, false otherwise. */
+        void computeKernel(const bool force = false) {
+            if(_detected && !force)
+                return;
+            if(!_schur) {
+                std::cerr << "The explicit Schur complement is not available => impossible to detect the kernel" << std::endl;
+                return;
+            }
+            const int n = Subdomain<K>::_dof;
+            K* const a = new K[n * n];
+            expandSchurComplement(a);
+            int* const piv = new int[n];
+            underlying_type<K>* const work = new underlying_type<K>[2 * n];
+            underlying_type<K> tol = Option::get()->val(super::prefix("substructuring_kernel_tol"), -1.0);
+            if(tol <= 0.0)
+                tol = std::sqrt(std::numeric_limits<underlying_type<K>>::epsilon());
+            underlying_type<K> max = 0.0;
+            for(int i = 0; i < n; ++i)
+                max = std::max(max, std::abs(a[i * (n + 1)]));
+            tol *= max;
+            int rank, info;
+            Lapack<K>::pstrf("L", &n, a, &n, piv, &rank, &tol, work, &info);
+            delete [] work;
+            const bool user = _deficiency && super::_ev;
+            if(user)
+                rank = std::max(n - _deficiency, 0);
+            else
+                _deficiency = n - rank;
+            _fixed.clear();
+            for(int i = rank; i < n; ++i)
+                _fixed.emplace_back(piv[i] - 1);
+            if(!user && _deficiency && !super::_ev) {
+                const int d = _deficiency;
+                super::_ev = new K*[d];
+                *super::_ev = new K[n * d];
+                K* const x = new K[n * d]();
+                for(int j = 0; j < d; ++j) {
+                    super::_ev[j] = *super::_ev + j * n;
+                    for(int i = 0; i < rank; ++i)
+                        x[i + j * n] = -Wrapper<K>::conj(a[rank + j + i * n]);
+                    x[rank + j + j * n] = K(1.0);
+                }
+                if(rank)
+                    Lapack<K>::trtrs("L", &(Wrapper<K>::transc), "N", &rank, &d, a, &n, x, &n, &info);
+                for(int j = 0; j < d; ++j)
+                    for(int i = 0; i < n; ++i)
+                        super::_ev[j][piv[i] - 1] = x[i + j * n];
+                delete [] x;
+                if(super::_co)
+                    super::_co->setLocal(d);
+                else
+                    super::initialize(d);
+            }
+            delete [] piv;
+            delete [] a;
+            _detected = true;
         }
         /* Function: callNumfactPreconditioner
          *  Factorizes <Schur::ii> if <Schur::schur> is not available. */
@@ -371,7 +1047,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             if(!_schur) {
                 if(_ii) {
                     if(_ii->_n)
-                        super::_s.numfact(_ii);
+                        factorizeInterior();
                 }
                 else
                     std::cerr << "The matrix '_ii' has not been allocated => impossible to build the Dirichlet preconditioner" << std::endl;
@@ -379,31 +1055,32 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         }
         /* Function: originalNumbering
          *
-         *  Renumbers a vector according to the numbering of the user.
+         *  Renumbers vectors according to the numbering of the user.
          *
          * Parameters:
-         *    interface      - Numbering of the interface.
-         *    in             - Input vector. */
+         *    interface      - Numbering of the interface, only kept for backward compatibility since <Schur::renumber> stores the permutation.
+         *    in             - Input vectors.
+         *    mu             - Number of vectors. */
         template<class Container>
-        void originalNumbering(const Container& interface, K* const in) const {
-            if(interface[0] != _bi->_m) {
-                unsigned int end = Subdomain<K>::_a->_n;
-                std::vector<K> backup(in + _bi->_m, in + end);
-                unsigned int j = Subdomain<K>::_dof;
-                while(j-- > 0 && j != interface[j]) {
-                    std::copy_backward(in + interface[j] - j - 1, in + end - j - 1, in + end);
-                    in[interface[j]] = backup[j];
-                    end = interface[j];
-                }
-                if(j < Subdomain<K>::_dof) {
-                    std::copy_backward(in, in + end - j - 1, in + end);
-                    std::copy_n(backup.begin(), j + 1, in);
-                }
-            }
+        void originalNumbering(const Container& interface, K* const in, const unsigned short& mu = 1) const {
+            permute<false>(in, mu);
         }
+        /* Function: internalNumbering
+         *
+         *  Renumbers vectors given in the numbering of the user according to the numbering of <Schur::renumber>, interior unknowns first and interface unknowns last. Right-hand sides and solution vectors may also be kept in this numbering to avoid any renumbering, cf. <Schur::getPermutation>.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    mu             - Number of vectors. */
+        void internalNumbering(K* const in, const unsigned short& mu = 1) const {
+            permute<true>(in, mu);
+        }
+        /* Function: getPermutation
+         *  Returns a constant reference to <Schur::permutation>. */
+        const std::vector<int>& getPermutation() const { return _permutation; }
         /* Function: renumber
          *
-         *  Renumbers <Subdomain::a> and <Preconditioner::ev> to easily assemble <Schur::bb>, <Schur::ii>, and <Schur::bi>.
+         *  Renumbers <Subdomain::a> and <Preconditioner::ev> to easily assemble <Schur::bb>, <Schur::ii>, and <Schur::bi>, and stores the permutation in <Schur::permutation>. If a partition has been supplied with <Schur::setLocalPartition> or if -hpddm_substructuring_local_subdomains is greater than one, <Subdomain::a> is first split into local subdomains, cf. <Schur::splitLocalSubdomain>, so that <Schur::ii> is block diagonal.
          *
          * Parameters:
          *    interface      - Numbering of the interface.
@@ -411,6 +1088,23 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         template<bool trim = true, class Container = std::vector<int>>
         void renumber(const Container& interface, K* const& f = nullptr) {
             if(!interface.empty()) {
+                if(!_ii && _blocks.empty()) {
+                    std::vector<unsigned short> part;
+                    part.swap(_partition);
+                    const unsigned short p = Option::get()->val<unsigned short>(super::prefix("substructuring_local_subdomains"), 1);
+                    if(part.empty() && p > 1) {
+                        part.resize(Subdomain<K>::_a->_n);
+                        for(int i = 0; i < Subdomain<K>::_a->_n; ++i)
+                            part[i] = (static_cast<long long>(i) * p) / Subdomain<K>::_a->_n;
+                    }
+                    if(!part.empty()) {
+                        renumber<trim>(splitLocalSubdomain(interface, part), f);
+                        _blocks.erase(std::remove_if(_blocks.begin(), _blocks.end(), [](const std::vector<int>& block) { return block.empty(); }), _blocks.end());
+                        if(_blocks.size() < 2)
+                            _blocks.clear();
+                        return;
+                    }
+                }
                 if(!_ii) {
                     Subdomain<K>::_dof = Subdomain<K>::_a->_n;
                     std::vector<signed int> vec;
@@ -540,21 +1234,14 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     Subdomain<K>::_a->_sym = true;
                     _ii = new MatrixCSR<K>(_bi->_m, _bi->_m, Subdomain<K>::_a->_ia[_bi->_m], Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, true);
                     Subdomain<K>::_dof = _bb->_n;
-                }
-                if(f && interface[0] != _bi->_m) {
-                    std::vector<K> backup;
-                    backup.reserve(interface.size());
-                    backup.emplace_back(f[interface[0]]);
-                    unsigned int j = 0;
-                    unsigned int start = 0;
-                    while(++j < interface.size()) {
-                        std::copy(f + interface[j - 1] + 1, f + interface[j], f + start);
-                        start = interface[j] - j;
-                        backup.emplace_back(f[interface[j]]);
+                    if(interface[0] != _bi->_m) {
+                        _permutation.resize(vec.size());
+                        for(unsigned int i = 0; i < vec.size(); ++i)
+                            _permutation[vec[i] < 0 ? -vec[i] - 1 : _bi->_m + vec[i] - 1] = i;
                     }
-                    std::copy(f + interface.back() + 1, f + Subdomain<K>::_a->_n, f + start);
-                    std::copy(backup.cbegin(), backup.cend(), f + _bi->_m);
                 }
+                if(f)
+                    internalNumbering(f);
             }
             else {
                 std::cerr << "The container of the interface is empty => no static condensation" << std::endl;
@@ -603,12 +1290,14 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                 if(_bi->_m) {
                     K* tmp = new K[n * _bi->_m];
                     Wrapper<K>::template csrmm<Wrapper<K>::I>(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), tmp, &_bi->_m);
-                    super::_s.solve(tmp, n);
+                    solveInterior(tmp, n);
                     Wrapper<K>::template csrmm<Wrapper<K>::I>("N", &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, tmp, &_bi->_m, &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
                     delete [] tmp;
                 }
                 Wrapper<K>::template csrmm<Wrapper<K>::I>("N", &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &_bb->_m, &(Wrapper<K>::d__2), out, &(Subdomain<K>::_dof));
             }
+            else if(!_tiles.empty())
+                applyCompressedSchurComplement(in, out, n);
             else
                 Blas<K>::symm("L", "L", &(Subdomain<K>::_dof), &n, &(Wrapper<K>::d__1), _schur, &(Subdomain<K>::_dof), in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
             delete [] in;
@@ -627,7 +1316,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             if(!_schur) {
                 Wrapper<K>::template csrmv<Wrapper<K>::I>(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, in, &(Wrapper<K>::d__0), _work);
                 if(_bi->_m)
-                    super::_s.solve(_work);
+                    solveInterior(_work);
                 if(out) {
                     Wrapper<K>::template csrmv<Wrapper<K>::I>("N", &(Subdomain<K>::_dof), &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, _work, &(Wrapper<K>::d__0), out);
                     Wrapper<K>::template csrmv<Wrapper<K>::I>("N", &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &(Wrapper<K>::d__2), out);
@@ -638,6 +1327,11 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     std::copy_n(_work + _bi->_m, Subdomain<K>::_dof, in);
                 }
             }
+            else if(!_tiles.empty()) {
+                applyCompressedSchurComplement(in, out ? out : _work + _bi->_m, i__1);
+                if(!out)
+                    std::copy_n(_work + _bi->_m, Subdomain<K>::_dof, in);
+            }
             else if(out)
                 Blas<K>::symv("L", &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _schur, &(Subdomain<K>::_dof), in, &i__1, &(Wrapper<K>::d__0), out, &i__1);
             else {
@@ -714,6 +1408,23 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Function: setDeficiency
          *  Sets <Schur::deficiency>. */
         void setDeficiency(unsigned short deficiency) { _deficiency = deficiency; }
+        /* Function: setLocalPartition
+         *
+         *  Sets <Schur::partition> before <Schur::renumber> to split the subdomain into local subdomains whose interior unknowns are factorized and solved concurrently.
+         *
+         * Parameter:
+         *    part           - Local subdomain of each unknown of <Subdomain::a>, in the numbering of the user. */
+        void setLocalPartition(const unsigned short* const part) { _partition.assign(part, part + Subdomain<K>::_a->_n); }
+        /* Function: adapt
+         *
+         *  Adapts the preconditioner during <IterativeMethod::PCG>, nothing is done by default.
+         *
+         * Parameters:
+         *    lanczos        - Step lengths and conjugation coefficients of the first right-hand side.
+         *    i              - Current iteration.
+         *    elapsed        - Time spent in the iterations.
+         *    reduction      - Remaining relative reduction of the residual. */
+        bool adapt(const underlying_type<K>* const lanczos, const unsigned short& i, const double& elapsed, const underlying_type<K>& reduction) const { return false; }
         /* Function: condensateEffort
          *
          *  Performs static condensation.
@@ -723,7 +1434,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *    b              - Condensed right-hand side. */
         void condensateEffort(const K* const f, K* const b) const {
             if(_bi->_m)
-                super::_s.solve(f, _structure);
+                solveInterior(f, _structure);
             std::copy_n(f + _bi->_m, Subdomain<K>::_dof, b ? b : _structure + _bi->_m);
             Wrapper<K>::template csrmv<Wrapper<K>::I>("N", &(Subdomain<K>::_dof), &_bi->_m, &(Wrapper<K>::d__2), false, _bi->_a, _bi->_ia, _bi->_ja, _structure, &(Wrapper<K>::d__1), b ? b : _structure + _bi->_m);
         }
@@ -50,21 +50,414 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          * SY           - Symmetric preconditioner, e.g. Additive Schwarz method.
          * GE           - Nonsymmetric preconditioner, e.g. Restricted Additive Schwarz method.
          * OS           - Optimized symmetric preconditioner, e.g. Optimized Schwarz method.
-         * OG           - Optimized nonsymmetric preconditioner, e.g. Optimized Restricted Additive Schwarz method. */
+         * OG           - Optimized nonsymmetric preconditioner, e.g. Optimized Restricted Additive Schwarz method.
+         * MU           - Multiplicative preconditioner by colors, e.g. Restricted Multiplicative Schwarz method. */
         enum class Prcndtnr : char {
-            NO, SY, GE, OS, OG
+            NO, SY, GE, OS, OG, MU
         };
     private:
         /* Variable: d
          *  Local partition of unity. */
         const underlying_type<K>* _d;
         std::size_t            _hash;
+        /* Variable: pattern
+         *  Hash of the indices of <Subdomain::a> when it was last factorized, cf. <Schwarz::updateValues>. */
+        std::size_t         _pattern;
+        /* Variable: fingerprint
+         *  Arrays of indices and number of nonzero entries of <Subdomain::a> when <Schwarz::pattern> was computed, so that <Schwarz::updateValues> only hashes the indices again if they changed. */
+        std::tuple<const int*, const int*, int> _fingerprint;
         /* Variable: type
          *  Type of <Prcndtnr> used in <Schwarz::apply> and <Schwarz::deflation>. */
         Prcndtnr               _type;
+        /* Variable: partition
+         *  Local subdomain of each unknown, cf. <Schwarz::setLocalPartition>, then owner of each unknown once <Schwarz::blocks> is built. */
+        std::vector<unsigned short> _partition;
+        /* Variable: blocks
+         *  Unknowns of each overlapping local subdomain when the subdomain is split by <Schwarz::splitLocalSubdomain>, empty otherwise. */
+        std::vector<std::vector<int>> _blocks;
+        /* Variable: local
+         *  Local matrices and their factorizations, one per local subdomain of <Schwarz::blocks>. */
+        std::vector<std::pair<MatrixCSR<K>*, Solver<K>*>> _local;
+        /* Variable: color
+         *  Color of the subdomain in the adjacency graph of the subdomains, cf. <Schwarz::colorSubdomains>. */
+        unsigned short        _color;
+        /* Variable: colors
+         *  Number of colors of the adjacency graph of the subdomains, zero if it has not been colored yet. */
+        unsigned short       _colors;
+        /* Variable: operator
+         *  User-supplied local matrix-vector product used in <Schwarz::GMV> instead of <Subdomain::a>, cf. <Schwarz::setOperator>. */
+        std::function<void(const K* const, K* const, const int&)> _operator;
+        /* Variable: roots
+         *  Roots of the residual polynomial of the polynomial preconditioner, cf. <Schwarz::polynomial>. With real scalars, a complex conjugate pair is stored once, as its real part and its positive imaginary part. */
+        mutable std::vector<std::pair<K, underlying_type<K>>> _roots;
+        /* Variable: degree
+         *  Degree of the polynomial preconditioner when <Schwarz::roots> were computed, zero if they must be computed again, e.g., after a new factorization. */
+        mutable unsigned short _degree;
+        /* Variable: polynomial
+         *  Type of the polynomial preconditioner when <Schwarz::roots> were computed. */
+        mutable char       _polynomial;
+        /* Variable: work
+         *  Workspace of <Schwarz::apply> with the polynomial preconditioner, allocated on first use and only reallocated for larger inputs. */
+        mutable K*               _work;
+        /* Variable: size
+         *  Size of the input vectors for which <Schwarz::work> is allocated. */
+        mutable int              _size;
+        /* Variable: correction
+         *  Coarse correction used instead of the one of <OptionsSnapshot> for the duration of a solve, cf. <Schwarz::setCoarseCorrection>, or -2 to follow the options. */
+        mutable char       _correction;
+        /* Function: coarseCorrection
+         *  Returns <Schwarz::correction> if it is set, the coarse correction of <OptionsSnapshot> otherwise. */
+        char coarseCorrection() const {
+            return _correction != -2 ? _correction : super::snapshot().schwarz_coarse_correction;
+        }
+        /* Function: localMV
+         *
+         *  Computes the local matrix-vector product, either with the user-supplied <Schwarz::operator> or with <Subdomain::a>.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        void localMV(const K* const in, K* const out, const int& mu) const {
+            if(_operator)
+                _operator(in, out, mu);
+            else if(HPDDM_NUMBERING == Wrapper<K>::I)
+                Wrapper<K>::csrmm(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), &mu, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
+            else if(Subdomain<K>::_a->_ia[Subdomain<K>::_dof] == Subdomain<K>::_a->_nnz)
+                Wrapper<K>::template csrmm<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), &mu, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
+            else
+                Wrapper<K>::template csrmm<'F'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), &mu, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
+        }
+        /* Function: colorSubdomains
+         *
+         *  Colors the adjacency graph of the subdomains defined by <Subdomain::map> with a greedy algorithm, each subdomain receiving the colors of its neighbors with lower ranks before picking the smallest available color. */
+        void colorSubdomains() {
+            int rank;
+            MPI_Comm_rank(Subdomain<K>::_communicator, &rank);
+            std::vector<unsigned short> colors(Subdomain<K>::_map.size());
+            std::vector<MPI_Request> rq;
+            rq.reserve(Subdomain<K>::_map.size());
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                if(Subdomain<K>::_map[i].first < rank) {
+                    rq.emplace_back();
+                    MPI_Irecv(colors.data() + i, 1, MPI_UNSIGNED_SHORT, Subdomain<K>::_map[i].first, 20, Subdomain<K>::_communicator, &rq.back());
+                }
+            MPI_Waitall(rq.size(), rq.data(), MPI_STATUSES_IGNORE);
+            std::vector<bool> taken(Subdomain<K>::_map.size() + 1);
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                if(Subdomain<K>::_map[i].first < rank && colors[i] < taken.size())
+                    taken[colors[i]] = true;
+            _color = std::distance(taken.cbegin(), std::find(taken.cbegin(), taken.cend(), false));
+            rq.clear();
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                if(Subdomain<K>::_map[i].first > rank) {
+                    rq.emplace_back();
+                    MPI_Isend(&_color, 1, MPI_UNSIGNED_SHORT, Subdomain<K>::_map[i].first, 20, Subdomain<K>::_communicator, &rq.back());
+                }
+            MPI_Waitall(rq.size(), rq.data(), MPI_STATUSES_IGNORE);
+            _colors = _color + 1;
+            MPI_Allreduce(MPI_IN_PLACE, &_colors, 1, MPI_UNSIGNED_SHORT, MPI_MAX, Subdomain<K>::_communicator);
+        }
+        /* Function: multiplicative
+         *
+         *  Applies the one-level multiplicative Schwarz method by sweeping over the colors of <Schwarz::colorSubdomains>, backward and forward if -hpddm_schwarz_multiplicative_sweep is set to symmetric. For each color, the subdomains of that color solve their local problem with the current residual, and their corrections, scaled by <Schwarz::d>, are exchanged. The residual is then updated with a distributed matrix-vector product of the summed corrections, i.e., two exchanges per color.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        void multiplicative(const K* const in, K* const out, const unsigned short& mu) const {
+            const int n = Subdomain<K>::_dof;
+            int dim = mu * n;
+            K* const r = new K[3 * dim];
+            K* const u = r + dim;
+            std::copy_n(in, dim, r);
+            std::fill_n(out, dim, K());
+            const unsigned short sweeps = (super::snapshot().schwarz_multiplicative_sweep == 1 ? 2 * _colors - 1 : _colors);
+            for(unsigned short k = 0; k < sweeps; ++k) {
+                if(_color == (k < _colors ? k : 2 * _colors - 2 - k)) {
+                    localSolve(r, u, mu);
+                    Wrapper<K>::diag(n, _d, u, mu);                                                         //  u = D A_i \ r
+                }
+                else
+                    std::fill_n(u, dim, K());
+                Subdomain<K>::exchange(u, mu);                                                              //  u = sum R_j^T D_j A_j \ R_j r
+                Blas<K>::axpy(&dim, &(Wrapper<K>::d__1), u, &i__1, out, &i__1);                             // out = out + u
+                if(std::any_of(u, u + dim, [](const K& v) { return v != K(); }))                           // only the subdomains of this color and their neighbors hold a nonzero correction
+                    localMV(u, u + dim, mu);
+                else
+                    std::fill_n(u + dim, dim, K());
+                scaledExchange(u + dim, mu);                                                                // Au = A u
+                Blas<K>::axpy(&dim, &(Wrapper<K>::d__2), u + dim, &i__1, r, &i__1);                         //   r = r - A u
+            }
+            delete [] r;
+        }
+        /* Function: splitLocalSubdomain
+         *
+         *  Splits <Subdomain::a> into -hpddm_schwarz_local_subdomains local subdomains, or according to <Schwarz::partition>, and extends each of them with -hpddm_schwarz_local_overlap layers of unknowns. Each unknown is owned by a single local subdomain, which defines a Boolean partition of unity on each local subdomain. */
+        template<char N = HPDDM_NUMBERING>
+        void splitLocalSubdomain() {
+            const std::string prefix = super::prefix();
+            const Option& opt = *Option::get();
+            const unsigned short p = opt.val<unsigned short>(prefix + "schwarz_local_subdomains", 1);
+            if(!_blocks.empty() || (_partition.empty() && p <= 1))
+                return;
+            const MatrixCSR<K>* const A = Subdomain<K>::_a;
+            const int n = Subdomain<K>::_dof;
+            if(_partition.empty()) {
+                _partition.resize(n);
+                for(int i = 0; i < n; ++i)
+                    _partition[i] = (static_cast<long long>(i) * p) / n;
+            }
+            std::vector<std::vector<int>> adjacency(n);
+            for(int i = 0; i < n; ++i)
+                for(int j = A->_ia[i] - (N == 'F'); j < A->_ia[i + 1] - (N == 'F'); ++j) {
+                    const int k = A->_ja[j] - (N == 'F');
+                    if(k != i) {
+                        adjacency[i].emplace_back(k);
+                        if(A->_sym)
+                            adjacency[k].emplace_back(i);
+                    }
+                }
+            const unsigned short overlap = opt.val<unsigned short>(prefix + "schwarz_local_overlap", 1);
+            _blocks.resize(*std::max_element(_partition.cbegin(), _partition.cend()) + 1);
+            std::vector<int> visited(n, -1);
+            for(int i = 0; i < n; ++i)
+                _blocks[_partition[i]].emplace_back(i);
+            for(unsigned short j = 0; j < _blocks.size(); ++j) {
+                std::vector<int>& block = _blocks[j];
+                for(const int& i : block)
+                    visited[i] = j;
+                for(unsigned int level = 0, begin = 0; level < overlap; ++level) {
+                    const unsigned int end = block.size();
+                    for(unsigned int k = begin; k < end; ++k)
+                        for(const int& i : adjacency[block[k]])
+                            if(visited[i] != j) {
+                                visited[i] = j;
+                                block.emplace_back(i);
+                            }
+                    begin = end;
+                }
+                std::sort(block.begin(), block.end());
+            }
+            std::vector<unsigned short> renumbering(_blocks.size());
+            unsigned short size = 0;
+            for(unsigned short j = 0; j < _blocks.size(); ++j) {
+                renumbering[j] = size;
+                if(!_blocks[j].empty())
+                    _blocks[size++].swap(_blocks[j]);
+            }
+            _blocks.resize(size);
+            for(unsigned short& i : _partition)
+                i = renumbering[i];
+            if(size < 2) {
+                _blocks.clear();
+                _partition.clear();
+            }
+        }
+        /* Function: factorizeLocal
+         *
+         *  Extracts the local matrices of <Schwarz::blocks> and factorizes them concurrently with OpenMP tasks. The solver of the local subdomains must then be thread-safe.
+         *
+         * Parameter:
+         *    A              - Matrix from which the local matrices are extracted. */
+        template<char N = HPDDM_NUMBERING>
+        void factorizeLocal(const MatrixCSR<K>* const A) {
+            for(const std::pair<MatrixCSR<K>*, Solver<K>*>& p : _local) {
+                delete p.first;
+                delete p.second;
+            }
+            _local.resize(_blocks.size());
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+            for(unsigned short j = 0; j < _blocks.size(); ++j) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(j)
+#endif
+                {
+                    _local[j].first = extract<N>(A, _blocks[j]);
+                    _local[j].second = new Solver<K>();
+                    _local[j].second->template numfact<N>(_local[j].first);
+                }
+            }
+        }
+        /* Function: extract
+         *
+         *  Extracts a principal submatrix.
+         *
+         * Parameters:
+         *    A              - Input matrix.
+         *    block          - Sorted rows and columns of the submatrix. */
+        template<char N = HPDDM_NUMBERING>
+        static MatrixCSR<K>* extract(const MatrixCSR<K>* const A, const std::vector<int>& block) {
+            std::vector<std::pair<int, K>> tmp;
+            int* ia = new int[block.size() + 1];
+            ia[0] = (N == 'F');
+            for(unsigned int i = 0; i < block.size(); ++i) {
+                for(int j = A->_ia[block[i]] - (N == 'F'); j < A->_ia[block[i] + 1] - (N == 'F'); ++j) {
+                    std::vector<int>::const_iterator it = std::lower_bound(block.cbegin(), block.cend(), A->_ja[j] - (N == 'F'));
+                    if(it != block.cend() && *it == A->_ja[j] - (N == 'F'))
+                        tmp.emplace_back(std::distance(block.cbegin(), it) + (N == 'F'), A->_a[j]);
+                }
+                ia[i + 1] = tmp.size() + (N == 'F');
+            }
+            MatrixCSR<K>* const B = new MatrixCSR<K>(block.size(), block.size(), tmp.size(), A->_sym);
+            delete [] B->_ia;
+            B->_ia = ia;
+            for(unsigned int j = 0; j < tmp.size(); ++j) {
+                B->_ja[j] = tmp[j].first;
+                B->_a[j] = tmp[j].second;
+            }
+            return B;
+        }
+        /* Function: update
+         *
+         *  Copies the values of a principal submatrix previously extracted with <Schwarz::extract>, assuming the sparsity pattern of the input matrix did not change.
+         *
+         * Parameters:
+         *    A              - Input matrix.
+         *    block          - Sorted rows and columns of the submatrix.
+         *    B              - Submatrix. */
+        template<char N = HPDDM_NUMBERING>
+        static void update(const MatrixCSR<K>* const A, const std::vector<int>& block, MatrixCSR<K>* const B) {
+            int k = 0;
+            for(unsigned int i = 0; i < block.size(); ++i)
+                for(int j = A->_ia[block[i]] - (N == 'F'); j < A->_ia[block[i] + 1] - (N == 'F'); ++j) {
+                    std::vector<int>::const_iterator it = std::lower_bound(block.cbegin(), block.cend(), A->_ja[j] - (N == 'F'));
+                    if(it != block.cend() && *it == A->_ja[j] - (N == 'F'))
+                        B->_a[k++] = A->_a[j];
+                }
+        }
+        /* Function: localSolve
+         *
+         *  Applies the local solver, either <Preconditioner::s> or a one-level Schwarz method on <Schwarz::blocks>, with a local solve per OpenMP task. Contributions of the local subdomains are summed in shared memory, restricted to the owned unknowns for <Prcndtnr::GE> and <Prcndtnr::OG>.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors, may be the same as the input vectors.
+         *    mu             - Number of vectors. */
+        void localSolve(const K* const in, K* const out, const unsigned short& mu) const {
+            if(_local.empty()) {
+                if(in == out)
+                    super::_s.solve(out, mu);
+                else
+                    super::_s.solve(in, out, mu);
+                return;
+            }
+            const int n = Subdomain<K>::_dof;
+            std::vector<K*> y(_blocks.size());
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+            for(unsigned short j = 0; j < _blocks.size(); ++j) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(j)
+#endif
+                {
+                    const std::vector<int>& block = _blocks[j];
+                    y[j] = new K[mu * block.size()];
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        for(unsigned int i = 0; i < block.size(); ++i)
+                            y[j][nu * block.size() + i] = in[nu * n + block[i]];
+                    _local[j].second->solve(y[j], mu);
+                }
+            }
+            const bool restricted = (_type == Prcndtnr::GE || _type == Prcndtnr::OG || _type == Prcndtnr::MU);
+            if(!restricted)
+                std::fill_n(out, mu * n, K());
+            for(unsigned short j = 0; j < _blocks.size(); ++j) {
+                const std::vector<int>& block = _blocks[j];
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    for(unsigned int i = 0; i < block.size(); ++i) {
+                        if(!restricted)
+                            out[nu * n + block[i]] += y[j][nu * block.size() + i];
+                        else if(_partition[block[i]] == j)
+                            out[nu * n + block[i]] = y[j][nu * block.size() + i];
+                    }
+                delete [] y[j];
+            }
+        }
+        /* Function: localSolve
+         *
+         *  Applies the local solver in-place. */
+        void localSolve(K* const x, const unsigned short& mu) const {
+            localSolve(x, x, mu);
+        }
+        /* Function: solveLocalGEVP
+         *
+         *  Solves one generalized eigenvalue problem per local subdomain of <Schwarz::blocks>, and concatenates the extended eigenvectors in <Preconditioner::ev>. Unless supplied, the right-hand side matrix of each local subdomain is the restriction of the left-hand side matrix scaled by both partitions of unity to the unknowns shared with other local or neighboring subdomains. The eigenvalue problems are solved one after the other since eigensolvers such as ARPACK are not reentrant.
+         *
+         * Parameters:
+         *    A              - Left-hand side matrix.
+         *    nu             - Number of eigenvectors requested per local subdomain, total number of eigenvectors on output.
+         *    threshold      - Precision of the eigensolver.
+         *    B              - Right-hand side matrix (optional). */
+        template<template<class> class Eps, char N = HPDDM_NUMBERING>
+        void solveLocalGEVP(MatrixCSR<K>* const& A, unsigned short& nu, const underlying_type<K>& threshold, MatrixCSR<K>* const& B) {
+            const int n = Subdomain<K>::_dof;
+            std::vector<unsigned short> multiplicity(n);
+            for(const std::vector<int>& block : _blocks)
+                for(const int& i : block)
+                    ++multiplicity[i];
+            for(const pairNeighbor& neighbor : Subdomain<K>::_map)
+                for(const int& i : neighbor.second)
+                    if(_d[i] > HPDDM_EPS)
+                        multiplicity[i] = std::max(multiplicity[i], static_cast<unsigned short>(2));
+            std::vector<std::pair<K**, unsigned short>> ev(_blocks.size());
+            for(unsigned short j = 0; j < _blocks.size(); ++j) {
+                const std::vector<int>& block = _blocks[j];
+                MatrixCSR<K>* const lhs = extract<N>(A, block);
+                MatrixCSR<K>* rhs;
+                if(B)
+                    rhs = extract<N>(B, block);
+                else {
+                    rhs = extract<N>(A, block);
+                    for(unsigned int i = 0; i < block.size(); ++i)
+                        for(int k = rhs->_ia[i] - (N == 'F'); k < rhs->_ia[i + 1] - (N == 'F'); ++k) {
+                            const int l = block[rhs->_ja[k] - (N == 'F')];
+                            if(multiplicity[block[i]] > 1 && multiplicity[l] > 1 && _partition[block[i]] == j && _partition[l] == j)
+                                rhs->_a[k] *= _d[block[i]] * _d[l];
+                            else
+                                rhs->_a[k] = K();
+                        }
+                }
+                Eps<K> evp(threshold, block.size(), nu);
+                evp.template solve<Solver>(lhs, rhs, ev[j].first, MPI_COMM_SELF);
+                ev[j].second = evp._nu;
+                delete rhs;
+                delete lhs;
+            }
+            nu = std::accumulate(ev.cbegin(), ev.cend(), 0, [](unsigned short sum, const std::pair<K**, unsigned short>& p) { return sum + p.second; });
+            if(super::_ev) {
+                if(*super::_ev)
+                    delete [] *super::_ev;
+                delete [] super::_ev;
+            }
+            super::_ev = new K*[std::max(nu, static_cast<unsigned short>(1))];
+            *super::_ev = nu ? new K[nu * n]() : nullptr;
+            for(unsigned short j = 0, k = 0; j < _blocks.size(); ++j) {
+                for(unsigned short i = 0; i < ev[j].second; ++i, ++k) {
+                    super::_ev[k] = *super::_ev + k * n;
+                    Wrapper<K>::sctr(_blocks[j].size(), ev[j].first[i], _blocks[j].data(), super::_ev[k]);
+                }
+                if(ev[j].second)
+                    delete [] *ev[j].first;
+                delete [] ev[j].first;
+            }
+        }
     public:
-        Schwarz() : _d(), _hash() { }
-        ~Schwarz() { _d = nullptr; }
+        Schwarz() : _d(), _hash(), _pattern(), _fingerprint(), _type(), _partition(), _blocks(), _local(), _color(), _colors(), _operator(), _roots(), _degree(), _polynomial(), _work(), _size(), _correction(-2) { }
+        ~Schwarz() {
+            _d = nullptr;
+            delete [] _work;
+            for(const std::pair<MatrixCSR<K>*, Solver<K>*>& p : _local) {
+                delete p.first;
+                delete p.second;
+            }
+        }
         /* Typedef: super
          *  Type of the immediate parent class <Preconditioner>. */
         typedef Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>, K> super;
@@ -78,7 +471,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
         template<char N = HPDDM_NUMBERING>
         void callNumfact(MatrixCSR<K>* const& A = nullptr) {
             const std::string prefix = super::prefix();
-            Option& opt = *Option::get();
+            const Option& opt = *Option::get();
             unsigned short m = opt.val<unsigned short>(prefix + "schwarz_method");
             if(A) {
                 std::size_t hash = A->hashIndices();
@@ -92,21 +485,114 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 switch(m) {
                     case 3:  _type = Prcndtnr::SY; break;
                     case 5:  _type = Prcndtnr::NO; break;
+                    case 6:  _type = Prcndtnr::MU; break;
                     default: _type = Prcndtnr::GE;
                 }
-            m = opt.val<unsigned short>(prefix + "reuse_preconditioner");
-            if(m <= 1)
-                super::_s.template numfact<N>(_type == Prcndtnr::OS || _type == Prcndtnr::OG ? A : Subdomain<K>::_a);
+            if(_type == Prcndtnr::MU && !_colors)
+                colorSubdomains();
+            m = super::snapshot().reuse_preconditioner;
+            if(m == 0 || super::_reuse == 0 || (m == 2 && (super::_refresh & 1))) {
+                const double time = MPI_Wtime();
+                splitLocalSubdomain<N>();
+                if(_type != Prcndtnr::OS && _type != Prcndtnr::OG) {
+                    _pattern = Subdomain<K>::_a->hashIndices();
+                    _fingerprint = std::make_tuple(Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, Subdomain<K>::_a->_nnz);
+                }
+                if(_blocks.empty())
+                    super::_s.template numfact<N>(_type == Prcndtnr::OS || _type == Prcndtnr::OG ? A : Subdomain<K>::_a);
+                else
+                    factorizeLocal<N>(_type == Prcndtnr::OS || _type == Prcndtnr::OG ? A : Subdomain<K>::_a);
+                super::refreshed(0, MPI_Wtime() - time);
+                _degree = 0;
+            }
             if(m >= 1)
-                opt[prefix + "reuse_preconditioner"] += 1;
+                ++super::_reuse;
+        }
+        /* Function: updateValues
+         *
+         *  Updates the values of <Subdomain::a> without changing its sparsity pattern, and factorizes it again reusing the symbolic analysis of the local solvers when possible. If the pattern changed since the last call to <Schwarz::callNumfact>, it is called instead, the indices being only hashed again if their arrays or number of nonzero entries are not the same as in <Schwarz::fingerprint>. Local matrices of <Schwarz::blocks> are updated in place. With <Prcndtnr::OS> or <Prcndtnr::OG>, the factorized matrix is not <Subdomain::a>, so only its values are updated. When -hpddm_reuse_preconditioner is set to adaptive, the local solvers are only factorized again if requested by <Preconditioner::refresh>. The coarse operator is not rebuilt.
+         *
+         * Parameters:
+         *    a              - New values, in the same order as the values of <Subdomain::a>.
+         *    takeOwnership  - True if the ownership of a is transferred, so that it becomes the array of values of <Subdomain::a> if the matrix owns its arrays, or is freed after being copied otherwise, false if a should only be copied. */
+        template<char N = HPDDM_NUMBERING>
+        void updateValues(const K* const a, const bool takeOwnership = false) {
+            MatrixCSR<K>* const A = Subdomain<K>::_a;
+            if(a != A->_a) {
+                if(takeOwnership && A->getFree()) {
+                    delete [] A->_a;
+                    A->_a = const_cast<K*>(a);
+                }
+                else {
+                    std::copy_n(a, A->_nnz, A->_a);
+                    if(takeOwnership)
+                        delete [] a;
+                }
+            }
+            if(_type == Prcndtnr::OS || _type == Prcndtnr::OG)
+                return;
+            if(_fingerprint != std::make_tuple(A->_ia, A->_ja, A->_nnz)) {
+                if(_pattern != A->hashIndices()) {
+                    super::_reuse = 0;
+                    callNumfact<N>();
+                    return;
+                }
+                _fingerprint = std::make_tuple(A->_ia, A->_ja, A->_nnz);
+            }
+            if(super::snapshot().reuse_preconditioner == 2 && !(super::_refresh & 1))
+                return;
+            const double time = MPI_Wtime();
+            if(_blocks.empty())
+                super::template refactorize<N>(super::_s, A, 0);
+            else {
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+                for(unsigned short j = 0; j < _blocks.size(); ++j) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(j)
+#endif
+                    {
+                        update<N>(A, _blocks[j], _local[j].first);
+                        super::template refactorize<N>(*_local[j].second, _local[j].first, 0);
+                    }
+                }
+            }
+            super::refreshed(0, MPI_Wtime() - time);
+            _degree = 0;
         }
         void setMatrix(MatrixCSR<K>* const& a) {
             bool fact = super::setMatrix(a) && _type != Prcndtnr::OS && _type != Prcndtnr::OG;
             if(fact) {
+                const double time = MPI_Wtime();
                 super::destroySolver();
-                super::_s.numfact(a);
+                if(_blocks.empty())
+                    super::_s.numfact(a);
+                else
+                    factorizeLocal(a);
+                super::refreshed(0, MPI_Wtime() - time);
+                _degree = 0;
             }
         }
+        /* Function: setLocalPartition
+         *
+         *  Sets <Schwarz::partition> before <Schwarz::callNumfact> or <Schwarz::solveGEVP> to split the subdomain into local subdomains, each with its own local solver, partition of unity, and GenEO vectors.
+         *
+         * Parameter:
+         *    part           - Local subdomain of each unknown. */
+        void setLocalPartition(const unsigned short* const part) {
+            _partition.assign(part, part + Subdomain<K>::_dof);
+            _blocks.clear();
+        }
+        /* Function: callSolve
+         *
+         *  Applies the local solver to multiple right-hand sides in-place, cf. <Schwarz::localSolve>.
+         *
+         * Parameters:
+         *    x              - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of input right-hand sides. */
+        void callSolve(K* const x, const unsigned short& n = 1) const { localSolve(x, n); }
         /* Function: multiplicityScaling
          *
          *  Builds the multiplicity scaling.
@@ -213,6 +699,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          * See also: <Bdd::buildTwo>, <Feti::buildTwo>. */
         template<unsigned short excluded = 0>
         std::pair<MPI_Request, const K*>* buildTwo(const MPI_Comm& comm) {
+            _degree = 0;
             return super::template buildTwo<excluded, MatrixMultiplication<Schwarz<Solver, CoarseSolver, S, K>, K>>(this, comm);
         }
         template<bool excluded = false>
@@ -230,12 +717,11 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             scaledExchange(x, mu);
             if(super::_co) {
                 unsigned short k = 1;
-                const std::string prefix = super::prefix();
-                const Option& opt = *Option::get();
-                if(opt.any_of(prefix + "krylov_method", { 4, 5 }) && !opt.val<unsigned short>(prefix + "recycle_same_system"))
-                    k = std::max(opt.val<int>(prefix + "recycle", 1), 1);
+                const OptionsSnapshot& opt = super::snapshot();
+                if((opt.krylov_method == 4 || opt.krylov_method == 5) && !opt.recycle_same_system)
+                    k = std::max(opt.recycle, 1);
                 super::start(mu * k);
-                if(opt.val<char>(prefix + "schwarz_coarse_correction") == 2) {
+                if(coarseCorrection() == 2) {
                     if(!excluded) {
                         K* tmp = new K[mu * Subdomain<K>::_dof];
                         GMV(x, tmp, mu);                                                  // tmp = A x
@@ -251,9 +737,9 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             }
             return allocate;
         }
-        /* Function: apply
+        /* Function: precondition
          *
-         *  Applies the global Schwarz preconditioner.
+         *  Applies the global Schwarz preconditioner, without the polynomial of <Schwarz::apply>.
          *
          * Template Parameter:
          *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
@@ -264,14 +750,48 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          *    mu             - Number of vectors.
          *    work           - Workspace array. */
         template<bool excluded = false>
-        void apply(const K* const in, K* const out, const unsigned short& mu = 1, K* work = nullptr) const {
-            const char correction = Option::get()->val<char>(super::prefix("schwarz_coarse_correction"), -1);
-            if(!super::_co || correction == -1) {
+        void precondition(const K* const in, K* const out, const unsigned short& mu = 1, K* work = nullptr) const {
+            const char correction = coarseCorrection();
+            if(_type == Prcndtnr::MU) {
+                int tmp = mu * Subdomain<K>::_dof;
+                if(!super::_co || correction == -1) {
+                    if(!excluded)
+                        multiplicative(in, out, mu);                                                        // out = M in
+                }
+                else if(correction == 2) {
+                    if(!excluded) {
+                        multiplicative(in, out, mu);
+                        K* const w = new K[tmp];
+                        GMV(out, w, mu);
+                        deflation<excluded>(nullptr, w, mu);
+                        Blas<K>::axpy(&tmp, &(Wrapper<K>::d__2), w, &i__1, out, &i__1);                     // out = (I - Z E \ Z^T A) M in
+                        delete [] w;
+                    }
+                    else
+                        deflation<excluded>(nullptr, nullptr, mu);
+                }
+                else {
+                    deflation<excluded>(in, out, mu);                                                       // out = Z E \ Z^T in
+                    if(!excluded) {
+                        K* const w = new K[2 * tmp];
+                        if(correction == 1)
+                            std::copy_n(in, tmp, w);
+                        else {
+                            GMV(out, w, mu);
+                            Blas<K>::axpby(tmp, 1.0, in, 1, -1.0, w, 1);                                    //   w = (I - A Z E \ Z^T) in
+                        }
+                        multiplicative(w, w + tmp, mu);
+                        Blas<K>::axpy(&tmp, &(Wrapper<K>::d__1), w + tmp, &i__1, out, &i__1);               // out = M w + Z E \ Z^T in
+                        delete [] w;
+                    }
+                }
+            }
+            else if(!super::_co || correction == -1) {
                 if(_type == Prcndtnr::NO)
                     std::copy_n(in, mu * Subdomain<K>::_dof, out);
                 else if(_type == Prcndtnr::GE || _type == Prcndtnr::OG) {
                     if(!excluded) {
-                        super::_s.solve(in, out, mu);
+                        localSolve(in, out, mu);
                         scaledExchange(out, mu);         // out = D A \ in
                     }
                 }
@@ -279,11 +799,11 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     if(!excluded) {
                         if(_type == Prcndtnr::OS) {
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, in, out, mu);
-                            super::_s.solve(out, mu);
+                            localSolve(out, mu);
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, out, mu);
                         }
                         else
-                            super::_s.solve(in, out, mu);
+                            localSolve(in, out, mu);
                         Subdomain<K>::exchange(out, mu); // out = A \ in
                     }
                 }
@@ -299,7 +819,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     MPI_Request rq[2];
                     Ideflation<excluded>(in, out, mu, rq);
                     if(!excluded) {
-                        super::_s.solve(work, mu);                                                                                                                                                         // out = A \ in
+                        localSolve(work, mu);                                                                                                                                                              // out = A \ in
                         MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
                         int k = mu;
                         Blas<K>::gemm("N", "N", &(Subdomain<K>::_dof), &k, super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, super::getAddrLocal(), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));                   // out = _ev E \ _ev^T D in
@@ -311,7 +831,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
 #else
                     deflation<excluded>(in, out, mu);
                     if(!excluded) {
-                        super::_s.solve(work, mu);
+                        localSolve(work, mu);
                         Blas<K>::axpy(&tmp, &(Wrapper<K>::d__1), work, &i__1, out, &i__1);
                         scaledExchange(out, mu);
                     }
@@ -321,7 +841,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     if(!excluded) {
                         if(_type == Prcndtnr::OS)
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, work, mu);
-                        super::_s.solve(work, out, mu);
+                        localSolve(work, out, mu);
                         scaledExchange(out, mu);
                         GMV(out, work, mu);
                         deflation<excluded>(nullptr, work, mu);
@@ -333,7 +853,13 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 else {
                     deflation<excluded>(in, out, mu);                                                                  // out = Z E \ Z^T in
                     if(!excluded) {
-                        if(HPDDM_NUMBERING == Wrapper<K>::I)
+                        if(_operator) {
+                            K* const w = new K[tmp = mu * Subdomain<K>::_dof];
+                            _operator(out, w, mu);
+                            Blas<K>::axpy(&tmp, &(Wrapper<K>::d__2), w, &i__1, work, &i__1);
+                            delete [] w;
+                        }
+                        else if(HPDDM_NUMBERING == Wrapper<K>::I)
                             Wrapper<K>::csrmm("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &(Subdomain<K>::_dof));
                         else if(Subdomain<K>::_a->_ia[Subdomain<K>::_dof] == Subdomain<K>::_a->_nnz)
                             Wrapper<K>::template csrmm<'C'>("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &(Subdomain<K>::_dof));
@@ -342,13 +868,223 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                         scaledExchange(work, mu);                                                                      //  in = (I - A Z E \ Z^T) in
                         if(_type == Prcndtnr::OS)
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, work, mu);
-                        super::_s.solve(work, mu);
+                        localSolve(work, mu);
                         scaledExchange(work, mu);                                                                      //  in = D A \ (I - A Z E \ Z^T) in
                         Blas<K>::axpy(&(tmp = mu * Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
                     }
                 }
             }
         }
+        /* Function: polynomial
+         *
+         *  Computes <Schwarz::roots> from a short Arnoldi process on the operator preconditioned by <Schwarz::precondition>, started from a random vector. With -hpddm_schwarz_polynomial gmres, the roots are the harmonic Ritz values of the preconditioned operator, i.e., the roots of the residual polynomial of the GMRES after as many iterations as the degree of the polynomial. With -hpddm_schwarz_polynomial chebyshev, at least ten iterations are used to estimate the interval in which lies the spectrum of the preconditioned operator, and the roots are the ones of the Chebyshev polynomial on this interval. The roots are then sorted in a modified Leja ordering to avoid overflows or underflows in <Schwarz::apply>.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    degree         - Degree of the polynomial.
+         *    type           - Type of polynomial. */
+        template<bool excluded>
+        void polynomial(const unsigned short& degree, const char type) const {
+            const int n = excluded ? 0 : Subdomain<K>::_dof;
+            const int m = type == 1 ? std::max(degree, static_cast<unsigned short>(10)) : degree;
+            const int ldh = m + 1;
+            K* const V = new K[(m + 3) * n + ldh * (m + 2)];
+            K* const scal = V + ldh * n;
+            K* const w = scal + n;
+            K* const H = w + n;
+            K* const dots = H + ldh * m;
+            auto norm = [&](const K* const v) {
+                underlying_type<K> nrm = 0.0;
+                if(!excluded) {
+                    Wrapper<K>::diag(n, _d, v, scal);
+                    nrm = std::real(Blas<K>::dot(&n, v, &i__1, scal, &i__1));
+                }
+                MPI_Allreduce(MPI_IN_PLACE, &nrm, 1, Wrapper<K>::mpi_underlying_type(), MPI_SUM, Subdomain<K>::_communicator);
+                return std::sqrt(nrm);
+            };
+            int rank;
+            MPI_Comm_rank(Subdomain<K>::_communicator, &rank);
+            {
+                std::mt19937 gen(rank);
+                std::uniform_real_distribution<underlying_type<K>> dis(-1.0, 1.0);
+                std::generate_n(V, n, [&]() { return K(dis(gen)); });
+            }
+            if(!excluded)
+                scaledExchange(V);
+            K alpha = 1.0 / norm(V);
+            Blas<K>::scal(&n, &alpha, V, &i__1);
+            std::fill_n(H, ldh * m, K());
+            int k = m;
+            for(int i = 0; i < m; ++i) {
+                K* const v = V + (i + 1) * n;
+                K* const h = H + i * ldh;
+                if(!excluded)
+                    GMV(V + i * n, w);
+                precondition<excluded>(w, v);
+                int j = i + 1;
+                for(unsigned short pass = 0; pass < 2; ++pass) {
+                    if(!excluded && n) {
+                        Wrapper<K>::diag(n, _d, v, scal);
+                        Blas<K>::gemv(&(Wrapper<K>::transc), &n, &j, &(Wrapper<K>::d__1), V, &n, scal, &i__1, &(Wrapper<K>::d__0), dots, &i__1);
+                    }
+                    else
+                        std::fill_n(dots, j, K());
+                    MPI_Allreduce(MPI_IN_PLACE, dots, j, Wrapper<K>::mpi_type(), MPI_SUM, Subdomain<K>::_communicator);
+                    if(!excluded && n)
+                        Blas<K>::gemv("N", &n, &j, &(Wrapper<K>::d__2), V, &n, dots, &i__1, &(Wrapper<K>::d__1), v, &i__1);
+                    Blas<K>::axpy(&j, &(Wrapper<K>::d__1), dots, &i__1, h, &i__1);
+                }
+                h[j] = norm(v);
+                if(std::real(h[j]) < HPDDM_EPS * Blas<K>::nrm2(&j, h, &i__1)) {
+                    k = j;
+                    break;
+                }
+                alpha = 1.0 / h[j];
+                Blas<K>::scal(&n, &alpha, v, &i__1);
+            }
+            K* const A = new K[2 * k * k + 3 * k];
+            K* const B = A + k * k;
+            K* const lambda = B + k * k;
+            if(type == 1) {
+                Wrapper<K>::template omatcopy<'N'>(k, k, H, ldh, A, k);
+                std::fill_n(B, k * k, K());
+                for(int i = 0; i < k; ++i)
+                    B[i * (k + 1)] = 1.0;
+            }
+            else {
+                int row = k + 1;
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &k, &k, &row, &(Wrapper<K>::d__1), H, &ldh, H, &ldh, &(Wrapper<K>::d__0), A, &k);
+                Wrapper<K>::template omatcopy<'C'>(k, k, H, ldh, B, k);
+            }
+            delete [] V;
+            int lwork = -1;
+            int info;
+            Lapack<K>::ggev("N", "N", &k, A, &k, B, &k, lambda, lambda + 2 * k, lambda + k, nullptr, &i__1, nullptr, &i__1, lambda, &lwork, nullptr, &info);
+            lwork = std::real(*lambda);
+            K* const work = new K[Wrapper<K>::is_complex ? (lwork + 4 * k) : lwork];
+            underlying_type<K>* const rwork = reinterpret_cast<underlying_type<K>*>(work + lwork);
+            Lapack<K>::ggev("N", "N", &k, A, &k, B, &k, lambda, lambda + 2 * k, lambda + k, nullptr, &i__1, nullptr, &i__1, work, &lwork, rwork, &info);
+            delete [] work;
+            std::vector<std::pair<unsigned short, std::complex<underlying_type<K>>>> q;
+            q.reserve(k);
+            selectNu(0, q, k, lambda, lambda + 2 * k, lambda + k);
+            delete [] A;
+            std::vector<std::complex<underlying_type<K>>> z;
+            z.reserve(std::max(k, static_cast<int>(degree)));
+            for(typename decltype(q)::const_reference p : q)
+                if(std::isfinite(std::abs(p.second)) && std::abs(p.second) > HPDDM_EPS && (Wrapper<K>::is_complex || std::imag(p.second) >= 0.0))
+                    z.emplace_back(p.second);
+            const OptionsSnapshot& opt = super::snapshot();
+            if(type == 1) {
+                underlying_type<K> bounds[2] = { std::numeric_limits<underlying_type<K>>::max(), 0.0 };
+                for(const std::complex<underlying_type<K>>& theta : z) {
+                    bounds[0] = std::min(bounds[0], std::real(theta));
+                    bounds[1] = std::max(bounds[1], std::real(theta));
+                }
+                z.clear();
+                if(bounds[0] > 0.0 && bounds[0] <= bounds[1]) {
+                    const underlying_type<K> pi = 3.141592653589793238463;
+                    bounds[1] *= 1.1;
+                    for(unsigned short i = 0; i < degree; ++i)
+                        z.emplace_back((bounds[1] + bounds[0]) / 2.0 + (bounds[1] - bounds[0]) / 2.0 * std::cos((2 * i + 1) * pi / (2 * degree)));
+                    if(opt.verbosity > 1 && rank == 0)
+                        std::cout << " --- spectrum of the preconditioned operator estimated in [" << bounds[0] << ", " << bounds[1] << "]" << std::endl;
+                }
+                else if(opt.verbosity && rank == 0)
+                    std::cout << "WARNING -- the estimated spectrum of the preconditioned operator is not positive, the Chebyshev polynomial is not used" << std::endl;
+            }
+            _roots.clear();
+            _roots.reserve(z.size());
+            std::vector<underlying_type<K>> distance(z.size(), 0.0);
+            while(!z.empty()) {
+                typename decltype(z)::iterator it = z.begin();
+                if(_roots.empty())
+                    it = std::max_element(z.begin(), z.end(), [](const std::complex<underlying_type<K>>& lhs, const std::complex<underlying_type<K>>& rhs) { return std::abs(lhs) < std::abs(rhs); });
+                else
+                    it += std::distance(distance.cbegin(), std::max_element(distance.cbegin(), distance.cend()));
+                const std::complex<underlying_type<K>> theta = *it;
+                distance.erase(distance.begin() + std::distance(z.begin(), it));
+                z.erase(it);
+                for(unsigned int i = 0; i < z.size(); ++i) {
+                    distance[i] += std::log(std::abs(z[i] - theta));
+                    if(std::imag(theta) > 0.0 && !Wrapper<K>::is_complex)
+                        distance[i] += std::log(std::abs(z[i] - std::conj(theta)));
+                }
+                _roots.emplace_back(*reinterpret_cast<const K*>(&theta), Wrapper<K>::is_complex ? 0.0 : std::imag(theta));
+            }
+            if(opt.verbosity > 1 && rank == 0 && !_roots.empty())
+                std::cout << " --- polynomial preconditioner with " << std::accumulate(_roots.cbegin(), _roots.cend(), 0, [](int sum, const std::pair<K, underlying_type<K>>& p) { return sum + (p.second == 0.0 ? 1 : 2); }) << " roots computed after " << k << " Arnoldi iteration" << (k > 1 ? "s" : "") << std::endl;
+            _degree = degree;
+            _polynomial = type;
+        }
+        /* Function: apply
+         *
+         *  Applies the global Schwarz preconditioner M, cf. <Schwarz::precondition>. If -hpddm_schwarz_polynomial_degree is set to d > 1, applies instead p(M A) M, where p is the polynomial of degree d - 1 such that 1 - p(M A) M A vanishes at <Schwarz::roots>. This requires d applications of M and d - 1 products with A, i.e., local solves, coarse corrections, and exchanges with neighbors, but no global reduction besides the ones of the coarse corrections, so that iterative methods need fewer iterations, and thus fewer global reductions, to converge.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors, modified internally if no workspace array is specified !
+         *    out            - Output vectors.
+         *    mu             - Number of vectors.
+         *    work           - Workspace array. */
+        template<bool excluded = false>
+        void apply(const K* const in, K* const out, const unsigned short& mu = 1, K* work = nullptr) const {
+            const OptionsSnapshot& opt = super::snapshot();
+            if(opt.schwarz_polynomial_degree < 2) {
+                precondition<excluded>(in, out, mu, work);
+                return;
+            }
+            if(_degree != opt.schwarz_polynomial_degree || _polynomial != opt.schwarz_polynomial)
+                polynomial<excluded>(opt.schwarz_polynomial_degree, opt.schwarz_polynomial);
+            if(_roots.empty()) {
+                precondition<excluded>(in, out, mu, work);
+                return;
+            }
+            int dim = excluded ? 0 : mu * Subdomain<K>::_dof;
+            if(dim > _size || !_work) {
+                delete [] _work;
+                _work = new K[3 * dim];
+                _size = dim;
+            }
+            K* const prod = _work;
+            K* const t = prod + dim;
+            K* const w = t + dim;
+            precondition<excluded>(in, prod, mu, work);                                                          // prod = M in
+            std::fill_n(out, dim, K());
+            for(typename decltype(_roots)::const_iterator it = _roots.cbegin(); it != _roots.cend(); ++it) {
+                const bool last = (it + 1 == _roots.cend());
+                if(it->second == 0.0) {
+                    K alpha = K(1.0) / it->first;
+                    Blas<K>::axpy(&dim, &alpha, prod, &i__1, out, &i__1);                                       // out = out + prod / theta
+                    if(!last) {
+                        if(!excluded)
+                            GMV(prod, w, mu);
+                        precondition<excluded>(w, t, mu);
+                        alpha = -alpha;
+                        Blas<K>::axpy(&dim, &alpha, t, &i__1, prod, &i__1);                                     // prod = (I - M A / theta) prod
+                    }
+                }
+                else {
+                    K alpha = K(1.0) / (std::norm(it->first) + it->second * it->second);
+                    if(!excluded)
+                        GMV(prod, w, mu);
+                    precondition<excluded>(w, t, mu);
+                    Blas<K>::axpby(dim, 2.0 * std::real(it->first), prod, 1, -1.0, t, 1);                      //    t = (2 Re(theta) I - M A) prod
+                    Blas<K>::axpy(&dim, &alpha, t, &i__1, out, &i__1);                                          //  out = out + t / |theta|^2
+                    if(!last) {
+                        if(!excluded)
+                            GMV(t, w, mu);
+                        precondition<excluded>(w, t, mu);
+                        alpha = -alpha;
+                        Blas<K>::axpy(&dim, &alpha, t, &i__1, prod, &i__1);                                     // prod = (I - M A / theta) (I - M A / conj(theta)) prod
+                    }
+                }
+            }
+        }
         /* Function: scaleIntoOverlap
          *
          *  Scales the input matrix using <Schwarz::d> on the overlap and sets the output matrix to zero elsewhere.
@@ -398,7 +1134,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
         }
         /* Function: solveGEVP
          *
-         *  Solves the generalized eigenvalue problem Ax = l Bx.
+         *  Solves the generalized eigenvalue problem Ax = l Bx, or one per local subdomain if the subdomain is split, cf. <Schwarz::solveLocalGEVP>.
          *
          * Parameters:
          *    A              - Left-hand side matrix.
@@ -407,6 +1143,16 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          *    threshold      - Precision of the eigensolver. */
         template<template<class> class Eps>
         void solveGEVP(MatrixCSR<K>* const& A, unsigned short& nu, const underlying_type<K>& threshold, MatrixCSR<K>* const& B = nullptr, const MatrixCSR<K>* const& pattern = nullptr) {
+            const double time = MPI_Wtime();
+            splitLocalSubdomain();
+            if(!_blocks.empty()) {
+                solveLocalGEVP<Eps>(A, nu, threshold, B);
+                Option::get()->set(super::prefix("geneo_nu"), nu);
+                if(super::_co)
+                    super::_co->setLocal(nu);
+                super::refreshed(2, MPI_Wtime() - time);
+                return;
+            }
             Eps<K> evp(threshold, Subdomain<K>::_dof, nu);
 #ifndef PY_MAJOR_VERSION
             bool free = pattern ? pattern->sameSparsity(A) : Subdomain<K>::_a->sameSparsity(A);
@@ -430,19 +1176,39 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 A->_ia = nullptr;
                 A->_ja = nullptr;
             }
-            (*Option::get())["geneo_nu"] = nu = evp._nu;
+            Option::get()->set(super::prefix("geneo_nu"), nu = evp._nu);
             if(super::_co)
                 super::_co->setLocal(nu);
             const int n = Subdomain<K>::_dof;
             std::for_each(super::_ev, super::_ev + nu, [&](K* const v) { std::replace_if(v, v + n, [](K x) { return std::abs(x) < 1.0 / (HPDDM_EPS * HPDDM_PEN); }, K()); });
+            super::refreshed(2, MPI_Wtime() - time);
         }
         template<bool sorted = true, bool scale = false>
         void interaction(std::vector<const MatrixCSR<K>*>& blocks) const {
             Subdomain<K>::template interaction<HPDDM_NUMBERING, sorted, scale>(blocks, _d);
         }
+        /* Function: setOperator
+         *
+         *  Sets <Schwarz::operator> so that <Schwarz::GMV> no longer needs <Subdomain::a>, which may then only hold an approximation of the operator, e.g., a low-order discretization, used by <Schwarz::callNumfact> and <Schwarz::solveGEVP>. The product must follow the same convention as <Subdomain::a>, i.e., the global product is recovered by scaling the local product by <Schwarz::d> and summing it with <Subdomain::exchange>.
+         *
+         * Parameter:
+         *    op             - Callable computing out = A_i in for mu vectors, with signature void(const K* in, K* out, const int& mu), or nullptr to go back to <Subdomain::a>. */
+        template<class Operator>
+        void setOperator(Operator&& op) {
+            _operator = std::forward<Operator>(op);
+        }
+        /* Function: setCoarseCorrection
+         *
+         *  Sets <Schwarz::correction> without modifying the options shared by all solves with the same prefix, e.g., in <IterativeMethod::ShiftedGMRES>.
+         *
+         * Parameter:
+         *    correction     - Coarse correction, with the same values as -hpddm_schwarz_coarse_correction, or -2 to follow the options again. */
+        void setCoarseCorrection(const char correction) const {
+            _correction = correction;
+        }
         /* Function: GMV
          *
-         *  Computes a global sparse matrix-vector product.
+         *  Computes a global sparse matrix-vector product, with <Schwarz::operator> if it has been set.
          *
          * Parameters:
          *    in             - Input vector.
@@ -462,12 +1228,8 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
 #else
             if(A)
                     Wrapper<K>::csrmm(A->_sym, &A->_n, &mu, A->_a, A->_ia, A->_ja, in, out);
-            else if(HPDDM_NUMBERING == Wrapper<K>::I)
-                    Wrapper<K>::csrmm(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), &mu, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
-            else if(Subdomain<K>::_a->_ia[Subdomain<K>::_dof] == Subdomain<K>::_a->_nnz)
-                Wrapper<K>::template csrmm<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), &mu, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
             else
-                Wrapper<K>::template csrmm<'F'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), &mu, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
+                localMV(in, out, mu);
             scaledExchange(out, mu);
 #endif
         }
@@ -26,6 +26,8 @@
 #ifndef _HPDDM_SUBDOMAIN_
 #define _HPDDM_SUBDOMAIN_
 
+#include <map>
+
 namespace HPDDM {
 /* Class: Subdomain
  *
@@ -53,6 +55,38 @@ class Subdomain : public OptionsPrefix {
         /* Variable: dof
          *  Number of degrees of freedom in the current subdomain. */
         int                        _dof;
+        /* Function: sparseExchange
+         *
+         *  Sends variable-sized messages to arbitrary processes, the receiving processes being unknown beforehand.
+         *
+         * Parameters:
+         *    send           - Messages to send to each process.
+         *    recv           - Messages received from each process.
+         *    type           - MPI datatype of the messages.
+         *    comm           - MPI communicator. */
+        template<class T>
+        static void sparseExchange(const std::vector<std::vector<T>>& send, std::vector<std::vector<T>>& recv, const MPI_Datatype& type, const MPI_Comm& comm) {
+            int size;
+            MPI_Comm_size(comm, &size);
+            std::vector<int> count(2 * size);
+            for(int i = 0; i < size; ++i)
+                count[i] = send[i].size();
+            MPI_Alltoall(count.data(), 1, MPI_INT, count.data() + size, 1, MPI_INT, comm);
+            recv.assign(size, std::vector<T>());
+            std::vector<MPI_Request> rq;
+            for(int i = 0; i < size; ++i) {
+                if(count[size + i]) {
+                    recv[i].resize(count[size + i]);
+                    rq.emplace_back();
+                    MPI_Irecv(recv[i].data(), count[size + i], type, i, 30, comm, &rq.back());
+                }
+                if(count[i]) {
+                    rq.emplace_back();
+                    MPI_Isend(const_cast<T*>(send[i].data()), count[i], type, i, 30, comm, &rq.back());
+                }
+            }
+            MPI_Waitall(rq.size(), rq.data(), MPI_STATUSES_IGNORE);
+        }
     public:
         Subdomain() : OptionsPrefix(), _a(), _buff(), _map(), _rq() { }
         ~Subdomain() {
@@ -69,24 +103,47 @@ class Subdomain : public OptionsPrefix {
         const vectorNeighbor& getMap() const { return _map; }
         /* Function: exchange
          *
-         *  Exchanges and reduces values of duplicated unknowns.
+         *  Exchanges and reduces values of duplicated unknowns. With multiple vectors, a single message per neighbor holds all values.
          *
-         * Parameter:
-         *    in             - Input vector. */
+         * Parameters:
+         *    in             - Input vectors.
+         *    mu             - Number of vectors. */
         void exchange(K* const in, const unsigned short& mu = 1) const {
-            for(unsigned short nu = 0; nu < mu; ++nu) {
+            if(mu == 1) {
                 for(unsigned short i = 0, size = _map.size(); i < size; ++i) {
                     MPI_Irecv(_buff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + i);
-                    Wrapper<K>::gthr(_map[i].second.size(), in + nu * _dof, _buff[size + i], _map[i].second.data());
+                    Wrapper<K>::gthr(_map[i].second.size(), in, _buff[size + i], _map[i].second.data());
                     MPI_Isend(_buff[size + i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + size + i);
                 }
                 for(unsigned short i = 0; i < _map.size(); ++i) {
                     int index;
                     MPI_Waitany(_map.size(), _rq, &index, MPI_STATUS_IGNORE);
                     for(unsigned int j = 0; j < _map[index].second.size(); ++j)
-                        in[_map[index].second[j] + nu * _dof] += _buff[index][j];
+                        in[_map[index].second[j]] += _buff[index][j];
+                }
+                MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
+            }
+            else if(!_map.empty()) {
+                const unsigned int n = _buff[_map.size()] - *_buff;
+                K* const recv = new K[2 * mu * n];
+                K* const send = recv + mu * n;
+                for(unsigned short i = 0, size = _map.size(); i < size; ++i) {
+                    const unsigned int offset = mu * (_buff[i] - *_buff);
+                    MPI_Irecv(recv + offset, mu * _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + i);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        Wrapper<K>::gthr(_map[i].second.size(), in + nu * _dof, send + offset + nu * _map[i].second.size(), _map[i].second.data());
+                    MPI_Isend(send + offset, mu * _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + size + i);
+                }
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    int index;
+                    MPI_Waitany(_map.size(), _rq, &index, MPI_STATUS_IGNORE);
+                    const K* const buff = recv + mu * (_buff[index] - *_buff);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        for(unsigned int j = 0; j < _map[index].second.size(); ++j)
+                            in[_map[index].second[j] + nu * _dof] += buff[nu * _map[index].second.size() + j];
                 }
                 MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
+                delete [] recv;
             }
         }
         /* Function: recvBuffer
@@ -155,6 +212,416 @@ class Subdomain : public OptionsPrefix {
             _rq = new MPI_Request[2 * _map.size()];
             _buff = new K*[2 * _map.size()];
         }
+        /* Function: repartition
+         *
+         *  Migrates the rows of a global matrix distributed by contiguous blocks of nonoverlapping rows to balance the number of nonzero entries per process, before <Subdomain::buildOverlap>. With coordinates, the new partition is computed by recursive coordinate bisection, unknowns with the same coordinate along the cut being split by their global number. Otherwise, the rows are split in contiguous blocks of the current numbering with equal weights. The rows are renumbered so that each process still owns a contiguous block of rows, and the coordinates, if any, follow the migrated rows.
+         *
+         * Template Parameter:
+         *    N              - 0- or 1-based indexing of the input and output matrices.
+         *
+         * Parameters:
+         *    a              - Local rows of the global matrix with global column indices, replaced by a newly allocated matrix owned by the caller, the input matrix is not freed.
+         *    first          - Global number of the first local row, updated to the new numbering.
+         *    origin         - Former global number of each new local row.
+         *    coordinates    - Coordinates of the unknowns of the local rows (optional), replaced by the coordinates of the new local rows.
+         *    dimension      - Number of coordinates per unknown.
+         *    comm           - MPI communicator. */
+        template<char N = HPDDM_NUMBERING>
+        void repartition(MatrixCSR<K>*& a, int& first, std::vector<int>& origin, std::vector<underlying_type<K>>* const coordinates = nullptr, const unsigned short dimension = 0, MPI_Comm* const& comm = nullptr) const {
+            const MPI_Comm communicator = comm ? *comm : MPI_COMM_WORLD;
+            int rank, size;
+            MPI_Comm_rank(communicator, &rank);
+            MPI_Comm_size(communicator, &size);
+            constexpr int shift = (N == 'F');
+            std::vector<int> range(size + 1);
+            MPI_Allgather(&first, 1, MPI_INT, range.data(), 1, MPI_INT, communicator);
+            range.back() = a->_m;
+            std::vector<int> owner(a->_n);
+            std::vector<double> weight(a->_n);
+            for(int i = 0; i < a->_n; ++i)
+                weight[i] = 1 + a->_ia[i + 1] - a->_ia[i];
+            const underlying_type<K>* const xyz = coordinates && dimension ? coordinates->data() : nullptr;
+            if(xyz) {
+                std::vector<std::pair<int, int>> parts { { 0, size } };
+                std::fill(owner.begin(), owner.end(), 0);
+                while(std::any_of(parts.cbegin(), parts.cend(), [](const std::pair<int, int>& p) { return p.second - p.first > 1; })) {
+                    const int n = parts.size();
+                    std::vector<int> index(size);
+                    for(int j = 0; j < n; ++j)
+                        index[parts[j].first] = j;
+                    std::vector<underlying_type<K>> box(2 * n * dimension, std::numeric_limits<underlying_type<K>>::max());
+                    for(int i = 0; i < a->_n; ++i)
+                        for(unsigned short k = 0; k < dimension; ++k) {
+                            box[index[owner[i]] * dimension + k] = std::min(box[index[owner[i]] * dimension + k], xyz[i * dimension + k]);
+                            box[(n + index[owner[i]]) * dimension + k] = std::min(box[(n + index[owner[i]]) * dimension + k], -xyz[i * dimension + k]);
+                        }
+                    MPI_Allreduce(MPI_IN_PLACE, box.data(), 2 * n * dimension, Wrapper<underlying_type<K>>::mpi_type(), MPI_MIN, communicator);
+                    std::vector<unsigned short> axis(n);
+                    std::vector<underlying_type<K>> lower(n), upper(n);
+                    for(int j = 0; j < n; ++j) {
+                        for(unsigned short k = 1; k < dimension; ++k)
+                            if(-box[(n + j) * dimension + k] - box[j * dimension + k] > -box[(n + j) * dimension + axis[j]] - box[j * dimension + axis[j]])
+                                axis[j] = k;
+                        lower[j] = box[j * dimension + axis[j]];
+                        upper[j] = -box[(n + j) * dimension + axis[j]];
+                    }
+                    std::vector<double> target(2 * n);
+                    for(int i = 0; i < a->_n; ++i)
+                        target[index[owner[i]]] += weight[i];
+                    MPI_Allreduce(MPI_IN_PLACE, target.data(), n, MPI_DOUBLE, MPI_SUM, communicator);
+                    for(int j = 0; j < n; ++j)
+                        target[j] *= static_cast<double>((parts[j].second - parts[j].first) / 2) / (parts[j].second - parts[j].first);
+                    for(unsigned short it = 0; it < std::numeric_limits<underlying_type<K>>::digits; ++it) {
+                        std::fill_n(target.begin() + n, n, 0.0);
+                        for(int i = 0; i < a->_n; ++i) {
+                            const int j = index[owner[i]];
+                            if(xyz[i * dimension + axis[j]] < (lower[j] + upper[j]) / 2)
+                                target[n + j] += weight[i];
+                        }
+                        MPI_Allreduce(MPI_IN_PLACE, target.data() + n, n, MPI_DOUBLE, MPI_SUM, communicator);
+                        for(int j = 0; j < n; ++j) {
+                            if(target[n + j] < target[j])
+                                lower[j] = (lower[j] + upper[j]) / 2;
+                            else
+                                upper[j] = (lower[j] + upper[j]) / 2;
+                        }
+                    }
+                    std::vector<int> split(2 * n);
+                    for(int j = 0; j < n; ++j)
+                        split[n + j] = a->_m;
+                    for(int bit = a->_m; bit > 0; bit /= 2) {
+                        std::fill_n(target.begin() + n, n, 0.0);
+                        for(int i = 0; i < a->_n; ++i) {
+                            const int j = index[owner[i]];
+                            if(xyz[i * dimension + axis[j]] < lower[j] || (xyz[i * dimension + axis[j]] < upper[j] && first + i < (split[j] + split[n + j]) / 2))
+                                target[n + j] += weight[i];
+                        }
+                        MPI_Allreduce(MPI_IN_PLACE, target.data() + n, n, MPI_DOUBLE, MPI_SUM, communicator);
+                        for(int j = 0; j < n; ++j) {
+                            if(target[n + j] < target[j])
+                                split[j] = (split[j] + split[n + j]) / 2;
+                            else
+                                split[n + j] = (split[j] + split[n + j]) / 2;
+                        }
+                    }
+                    for(int i = 0; i < a->_n; ++i) {
+                        const int j = index[owner[i]];
+                        if(parts[j].second - parts[j].first > 1 && xyz[i * dimension + axis[j]] >= lower[j] && (xyz[i * dimension + axis[j]] >= upper[j] || first + i >= (split[j] + split[n + j]) / 2))
+                            owner[i] = parts[j].first + (parts[j].second - parts[j].first) / 2;
+                    }
+                    std::vector<std::pair<int, int>> next;
+                    next.reserve(2 * n);
+                    for(const std::pair<int, int>& p : parts) {
+                        if(p.second - p.first > 1) {
+                            next.emplace_back(p.first, p.first + (p.second - p.first) / 2);
+                            next.emplace_back(p.first + (p.second - p.first) / 2, p.second);
+                        }
+                        else
+                            next.emplace_back(p);
+                    }
+                    parts.swap(next);
+                }
+            }
+            else {
+                double offset = std::accumulate(weight.cbegin(), weight.cend(), 0.0), total;
+                MPI_Allreduce(&offset, &total, 1, MPI_DOUBLE, MPI_SUM, communicator);
+                MPI_Exscan(MPI_IN_PLACE, &offset, 1, MPI_DOUBLE, MPI_SUM, communicator);
+                if(rank == 0)
+                    offset = 0.0;
+                for(int i = 0; i < a->_n; ++i) {
+                    owner[i] = std::min(static_cast<int>((offset + weight[i] / 2) * size / total), size - 1);
+                    offset += weight[i];
+                }
+            }
+            std::vector<int> count(3 * size);
+            for(int i = 0; i < a->_n; ++i)
+                ++count[owner[i]];
+            MPI_Exscan(count.data(), count.data() + size, size, MPI_INT, MPI_SUM, communicator);
+            if(rank == 0)
+                std::fill_n(count.begin() + size, size, 0);
+            MPI_Reduce_scatter_block(count.data(), count.data() + 2 * size, 1, MPI_INT, MPI_SUM, communicator);
+            const int n = count[2 * size];
+            int start = 0;
+            MPI_Exscan(&n, &start, 1, MPI_INT, MPI_SUM, communicator);
+            if(rank == 0)
+                start = 0;
+            std::vector<int> begin(size);
+            MPI_Allgather(&start, 1, MPI_INT, begin.data(), 1, MPI_INT, communicator);
+            std::vector<int> renumbering(a->_n);
+            for(int i = 0; i < a->_n; ++i)
+                renumbering[i] = begin[owner[i]] + count[size + owner[i]]++;
+            std::vector<std::vector<int>> request(size), recv;
+            std::unordered_map<int, int> ghost;
+            for(int i = 0; i < a->_nnz; ++i) {
+                const int c = a->_ja[i] - shift;
+                if((c < first || c >= first + a->_n) && ghost.emplace(c, 0).second)
+                    request[std::distance(range.cbegin(), std::upper_bound(range.cbegin(), range.cend(), c)) - 1].emplace_back(c);
+            }
+            sparseExchange(request, recv, MPI_INT, communicator);
+            for(std::vector<int>& r : recv)
+                for(int& c : r)
+                    c = renumbering[c - first];
+            {
+                std::vector<std::vector<int>> reply;
+                sparseExchange(recv, reply, MPI_INT, communicator);
+                for(int i = 0; i < size; ++i)
+                    for(unsigned int j = 0; j < request[i].size(); ++j)
+                        ghost[request[i][j]] = reply[i][j];
+            }
+            std::vector<std::vector<int>> structure(size);
+            std::vector<std::vector<K>> values(size), rvalues;
+            for(int i = 0; i < a->_n; ++i) {
+                std::vector<int>& s = structure[owner[i]];
+                s.emplace_back(first + i);
+                s.emplace_back(a->_ia[i + 1] - a->_ia[i]);
+                for(int j = a->_ia[i] - shift; j < a->_ia[i + 1] - shift; ++j) {
+                    const int c = a->_ja[j] - shift;
+                    s.emplace_back(c >= first && c < first + a->_n ? renumbering[c - first] : ghost[c]);
+                }
+                values[owner[i]].insert(values[owner[i]].end(), a->_a + a->_ia[i] - shift, a->_a + a->_ia[i + 1] - shift);
+            }
+            sparseExchange(structure, recv, MPI_INT, communicator);
+            sparseExchange(values, rvalues, Wrapper<K>::mpi_type(), communicator);
+            if(xyz) {
+                std::vector<std::vector<underlying_type<K>>> points(size), rpoints;
+                for(int i = 0; i < a->_n; ++i)
+                    points[owner[i]].insert(points[owner[i]].end(), xyz + i * dimension, xyz + (i + 1) * dimension);
+                sparseExchange(points, rpoints, Wrapper<underlying_type<K>>::mpi_type(), communicator);
+                coordinates->clear();
+                coordinates->reserve(n * dimension);
+                for(const std::vector<underlying_type<K>>& p : rpoints)
+                    coordinates->insert(coordinates->end(), p.cbegin(), p.cend());
+            }
+            unsigned int nnz = 0;
+            for(int i = 0; i < size; ++i)
+                nnz += rvalues[i].size();
+            MatrixCSR<K>* A = new MatrixCSR<K>(n, a->_m, nnz, a->_sym);
+            origin.resize(n);
+            A->_ia[0] = shift;
+            for(int i = 0, k = 0; i < size; ++i) {
+                std::vector<int>::const_iterator it = recv[i].cbegin();
+                typename std::vector<K>::const_iterator val = rvalues[i].cbegin();
+                while(it != recv[i].cend()) {
+                    origin[k] = *it;
+                    A->_ia[k + 1] = A->_ia[k] + it[1];
+                    std::vector<std::pair<int, K>> row;
+                    row.reserve(it[1]);
+                    for(int j = 0; j < it[1]; ++j)
+                        row.emplace_back(it[2 + j], val[j]);
+                    std::sort(row.begin(), row.end(), [](const std::pair<int, K>& lhs, const std::pair<int, K>& rhs) { return lhs.first < rhs.first; });
+                    for(int j = 0; j < it[1]; ++j) {
+                        A->_ja[A->_ia[k] - shift + j] = row[j].first + shift;
+                        A->_a[A->_ia[k] - shift + j] = row[j].second;
+                    }
+                    val += it[1];
+                    it += 2 + it[1];
+                    ++k;
+                }
+            }
+            char verbosity = Option::get()->val<char>(prefix("verbosity"), 0);
+            MPI_Bcast(&verbosity, 1, MPI_CHAR, 0, communicator); // the verbosity may only be set on the root process
+            if(verbosity > 0) {
+                long long stats[2][3] { };
+                const MatrixCSR<K>* const m[2] { a, A };
+                const int f[2] { first, start };
+                for(unsigned short k = 0; k < 2; ++k) {
+                    stats[k][0] = m[k]->_n;
+                    stats[k][1] = m[k]->_ia[m[k]->_n] - m[k]->_ia[0];
+                    for(int j = 0; j < stats[k][1]; ++j)
+                        stats[k][2] += (m[k]->_ja[j] - shift < f[k] || m[k]->_ja[j] - shift >= f[k] + m[k]->_n);
+                }
+                long long max[2][3], sum[2][3];
+                MPI_Reduce(&stats[0][0], &max[0][0], 6, MPI_LONG_LONG, MPI_MAX, 0, communicator);
+                MPI_Reduce(&stats[0][0], &sum[0][0], 6, MPI_LONG_LONG, MPI_SUM, 0, communicator);
+                if(rank == 0) {
+                    std::cout << "Repartitioning with " << (xyz ? "recursive coordinate bisection" : "weighted contiguous blocks") << ":" << std::endl;
+                    std::cout << " --- imbalance of rows (max/avg): " << static_cast<double>(max[0][0]) * size / sum[0][0] << " -> " << static_cast<double>(max[1][0]) * size / sum[1][0] << std::endl;
+                    std::cout << " --- imbalance of nonzeros (max/avg): " << static_cast<double>(max[0][1]) * size / sum[0][1] << " -> " << static_cast<double>(max[1][1]) * size / sum[1][1] << std::endl;
+                    std::cout << " --- off-process nonzeros: " << sum[0][2] << " -> " << sum[1][2] << std::endl;
+                }
+            }
+            a = A;
+            first = start;
+        }
+        /* Function: buildOverlap
+         *
+         *  Builds an overlapping local matrix, <Subdomain::map>, and a partition of unity from a global matrix distributed by contiguous blocks of nonoverlapping rows, and then initializes the subdomain. The overlap is grown algebraically one layer at a time, the rows of the new unknowns being fetched from the processes owning them. Local unknowns are sorted by global number, so that with a Boolean partition of unity, the rows of the input matrix are the local unknowns where the partition of unity equals one, in the same order. With a smooth partition of unity, the weight of an unknown in layer l of the overlap is 1 - l / overlap before normalization, so that it vanishes on the outermost layer, where the local matrix is truncated.
+         *
+         * Template Parameter:
+         *    N              - 0- or 1-based indexing of the input and output matrices.
+         *
+         * Parameters:
+         *    a              - Local rows of the global matrix with global column indices, stored without symmetry, the number of columns being the global number of unknowns.
+         *    first          - Global number of the first local row.
+         *    overlap        - Number of layers of overlap, at least one being needed by the global matrix-vector product.
+         *    d              - Local partition of unity, allocated by this function but owned by the caller.
+         *    smooth         - True for a partition of unity decreasing linearly in the overlap, false for a Boolean partition of unity.
+         *    sym            - True to only store the lower triangular part of the overlapping local matrix.
+         *    comm           - MPI communicator of the domain decomposition.
+         *    numbering      - Global number of each local unknown (optional). */
+        template<char N = HPDDM_NUMBERING>
+        void buildOverlap(const MatrixCSR<K>* const a, const int first, const unsigned short overlap, underlying_type<K>*& d, const bool smooth = false, const bool sym = false, MPI_Comm* const& comm = nullptr, std::vector<int>* const numbering = nullptr) {
+            const MPI_Comm communicator = comm ? *comm : MPI_COMM_WORLD;
+            int rank, size;
+            MPI_Comm_rank(communicator, &rank);
+            MPI_Comm_size(communicator, &size);
+            std::vector<int> range(size + 1);
+            MPI_Allgather(&first, 1, MPI_INT, range.data(), 1, MPI_INT, communicator);
+            range.back() = a->_m;
+            const int last = first + a->_n;
+            constexpr int shift = (N == 'F');
+            std::unordered_map<int, std::pair<std::vector<int>, std::vector<K>>> rows;
+            std::unordered_map<int, unsigned short> layer;
+            std::unordered_map<int, std::vector<int>> holders;
+            std::vector<std::vector<int>> requested(size), asked(size);
+            std::vector<int> frontier(a->_n);
+            std::iota(frontier.begin(), frontier.end(), first);
+            for(unsigned short l = 1; l <= std::max(overlap, static_cast<unsigned short>(1)); ++l) {
+                std::vector<std::vector<int>> request(size);
+                for(const int& g : frontier) {
+                    const int* begin, *end;
+                    if(g >= first && g < last) {
+                        begin = a->_ja + a->_ia[g - first] - shift;
+                        end = a->_ja + a->_ia[g - first + 1] - shift;
+                    }
+                    else {
+                        begin = rows[g].first.data();
+                        end = begin + rows[g].first.size();
+                    }
+                    for(const int* it = begin; it != end; ++it) {
+                        const int c = *it - (g >= first && g < last ? shift : 0);
+                        if((c < first || c >= last) && layer.emplace(c, l).second)
+                            request[std::distance(range.cbegin(), std::upper_bound(range.cbegin(), range.cend(), c)) - 1].emplace_back(c);
+                    }
+                }
+                frontier.clear();
+                std::vector<std::vector<int>> recv;
+                sparseExchange(request, recv, MPI_INT, communicator);
+                std::vector<std::vector<int>> structure(size);
+                std::vector<std::vector<K>> values(size);
+                for(int i = 0; i < size; ++i) {
+                    for(const int& g : recv[i]) {
+                        holders[g].emplace_back(i);
+                        const int begin = a->_ia[g - first] - shift, end = a->_ia[g - first + 1] - shift;
+                        structure[i].emplace_back(end - begin);
+                        std::transform(a->_ja + begin, a->_ja + end, std::back_inserter(structure[i]), [&](const int& j) { return j - shift; });
+                        values[i].insert(values[i].end(), a->_a + begin, a->_a + end);
+                    }
+                    asked[i].insert(asked[i].end(), recv[i].cbegin(), recv[i].cend());
+                }
+                std::vector<std::vector<K>> rvalues;
+                sparseExchange(structure, recv, MPI_INT, communicator);
+                sparseExchange(values, rvalues, Wrapper<K>::mpi_type(), communicator);
+                for(int i = 0; i < size; ++i) {
+                    std::vector<int>::const_iterator it = recv[i].cbegin();
+                    typename std::vector<K>::const_iterator val = rvalues[i].cbegin();
+                    for(const int& g : request[i]) {
+                        std::pair<std::vector<int>, std::vector<K>>& row = rows[g];
+                        row.first.assign(it + 1, it + 1 + *it);
+                        row.second.assign(val, val + *it);
+                        val += *it;
+                        it += 1 + *it;
+                        frontier.emplace_back(g);
+                    }
+                    requested[i].insert(requested[i].end(), request[i].cbegin(), request[i].cend());
+                }
+            }
+            std::map<int, std::vector<int>> shared;
+            {
+                std::vector<std::vector<int>> reply(size), recv;
+                for(int i = 0; i < size; ++i)
+                    for(const int& g : asked[i]) {
+                        const std::vector<int>& h = holders[g];
+                        reply[i].emplace_back(h.size());
+                        reply[i].insert(reply[i].end(), h.cbegin(), h.cend());
+                        shared[i].emplace_back(g);
+                    }
+                sparseExchange(reply, recv, MPI_INT, communicator);
+                for(int i = 0; i < size; ++i) {
+                    std::vector<int>::const_iterator it = recv[i].cbegin();
+                    for(const int& g : requested[i]) {
+                        shared[i].emplace_back(g);
+                        for(std::vector<int>::const_iterator h = it + 1; h != it + 1 + *it; ++h)
+                            if(*h != rank)
+                                shared[*h].emplace_back(g);
+                        it += 1 + *it;
+                    }
+                }
+            }
+            std::vector<int> glob;
+            glob.reserve(a->_n + layer.size());
+            for(int g = first; g < last; ++g)
+                glob.emplace_back(g);
+            for(const auto& g : layer)
+                glob.emplace_back(g.first);
+            std::sort(glob.begin(), glob.end());
+            const int n = glob.size();
+            std::vector<std::vector<std::pair<int, K>>> local(n);
+            unsigned int nnz = 0;
+            for(int k = 0; k < n; ++k) {
+                const int g = glob[k];
+                const bool owned = (g >= first && g < last);
+                const int* const ja = owned ? a->_ja + a->_ia[g - first] - shift : rows[g].first.data();
+                const K* const v = owned ? a->_a + a->_ia[g - first] - shift : rows[g].second.data();
+                const int m = owned ? a->_ia[g - first + 1] - a->_ia[g - first] : rows[g].first.size();
+                for(int j = 0; j < m; ++j) {
+                    std::vector<int>::const_iterator it = std::lower_bound(glob.cbegin(), glob.cend(), ja[j] - (owned ? shift : 0));
+                    if(it != glob.cend() && *it == ja[j] - (owned ? shift : 0) && (!sym || std::distance(glob.cbegin(), it) <= k))
+                        local[k].emplace_back(std::distance(glob.cbegin(), it), v[j]);
+                }
+                std::sort(local[k].begin(), local[k].end(), [](const std::pair<int, K>& lhs, const std::pair<int, K>& rhs) { return lhs.first < rhs.first; });
+                nnz += local[k].size();
+            }
+            MatrixCSR<K>* A = new MatrixCSR<K>(n, n, nnz, sym);
+            A->_ia[0] = shift;
+            for(int k = 0; k < n; ++k) {
+                A->_ia[k + 1] = A->_ia[k] + local[k].size();
+                for(unsigned int j = 0; j < local[k].size(); ++j) {
+                    A->_ja[A->_ia[k] - shift + j] = local[k][j].first + shift;
+                    A->_a[A->_ia[k] - shift + j] = local[k][j].second;
+                }
+                std::vector<std::pair<int, K>>().swap(local[k]);
+            }
+            std::vector<int> o;
+            std::vector<std::vector<int>> r;
+            o.reserve(shared.size());
+            r.reserve(shared.size());
+            for(std::pair<const int, std::vector<int>>& p : shared) {
+                std::sort(p.second.begin(), p.second.end());
+                o.emplace_back(p.first);
+                r.emplace_back();
+                r.back().reserve(p.second.size());
+                for(const int& g : p.second)
+                    r.back().emplace_back(std::distance(glob.cbegin(), std::lower_bound(glob.cbegin(), glob.cend(), g)));
+            }
+            initialize(A, o, r, comm);
+            d = new underlying_type<K>[n];
+            if(!smooth)
+                for(int k = 0; k < n; ++k)
+                    d[k] = (glob[k] >= first && glob[k] < last);
+            else {
+                K* const w = new K[n];
+                for(int k = 0; k < n; ++k)
+                    w[k] = (glob[k] >= first && glob[k] < last ? 1.0 : 1.0 - layer[glob[k]] / static_cast<underlying_type<K>>(std::max(overlap, static_cast<unsigned short>(1))));
+                for(int k = 0; k < n; ++k)
+                    d[k] = std::real(w[k]);
+                bool allocate = setBuffer();
+                exchange(w);
+                clearBuffer(allocate);
+                for(int k = 0; k < n; ++k)
+                    d[k] /= std::real(w[k]);
+                delete [] w;
+            }
+            if(numbering)
+                *numbering = std::move(glob);
+        }
+        /* Function: setBuffer
+         *
+         *  Sets up the buffers of <Subdomain::exchange> in a single contiguous array of twice the number of duplicated unknowns. For a neighbor i, _buff[i] points to the values received from it and _buff[_map.size() + i] to the values sent to it, the receive buffers being packed first in the order of <Subdomain::map>, followed by the send buffers in the same order. With multiple vectors, <Subdomain::exchange> reuses the offsets _buff[i] - *_buff, scaled by the number of vectors, to pack all values exchanged with a neighbor in a single message.
+         *
+         * Parameters:
+         *    wk             - Workspace used instead of a new allocation if large enough.
+         *    space          - Size of the workspace. */
         bool setBuffer(K* wk = nullptr, const int& space = 0) const {
             unsigned int n = 0;
             for(const auto& i : _map)
@@ -741,11 +1208,11 @@ inline void IterativeMethod::preprocess(const Operator& A, const K* const b, K*&
             std::copy_n(b, mu * A.getDof(), x);
         A.Subdomain<K>::template scatter<excluded>(x, sb, mu, k, comm);
         Option& opt = *Option::get();
-        opt[prefix + "enlarge_krylov_subspace"] = k;
+        opt.set(prefix + "enlarge_krylov_subspace", k);
         if(mu > 1)
             opt.remove(prefix + "initial_deflation_tol");
-        if(!opt.any_of(prefix + "krylov_method", { 1, 3, 5 })) {
-            opt[prefix + "krylov_method"] = 1;
+        if(!opt.any_of(prefix + "krylov_method", { 1, 3, 5, 9, 10 })) {
+            opt.set(prefix + "krylov_method", 1);
             if(opt.val<char>(prefix + "verbosity", 0))
                 std::cout << "WARNING -- block iterative methods should be used when enlarging Krylov subspaces, now switching to BGMRES" << std::endl;
         }